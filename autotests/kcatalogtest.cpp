@@ -33,15 +33,14 @@ private Q_SLOTS:
         const QByteArray before = qgetenv("LANGUAGE");
         QCOMPARE(before.size(), len);
 
-        // This goes through KCatalog::translate(), which will get the value of the
-        // LANGUAGE env var and copy it to to a char[64] array
+        // This goes through KCatalog::translate(), which reads the catalog
+        // directly and must not touch the LANGUAGE env var
         auto c = KCountry::fromAlpha2(u"NZ");
         QVERIFY(c.isValid());
         QCOMPARE(c.name(), QStringLiteral("Nouvelle-Zélande"));
 
-        QByteArray after = qgetenv("LANGUAGE");
-        // LANGUAGE env var value was truncated
-        QCOMPARE(after.size(), 64 - strlen("LANGUAGE=") - 1);
+        const QByteArray after = qgetenv("LANGUAGE");
+        QCOMPARE(after, before);
     }
 };
 
@@ -3,3 +3,11 @@
 if(NOT EXISTS "destdir/share/locale/de/LC_MESSAGES/plasma_applet_org.kde.plasma.katesessions.mo")
     message(SEND_ERROR "destdir/share/locale/de/LC_MESSAGES/plasma_applet_org.kde.plasma.katesessions.mo was not found")
 endif()
+
+# Broken KUIT markup in translations is only warned about, also in
+# catalogs that are not encoded in UTF-8.
+foreach(name ki18n_install_markup ki18n_install_latin1)
+    if(NOT EXISTS "destdir/share/locale/de/LC_MESSAGES/${name}.mo")
+        message(SEND_ERROR "destdir/share/locale/de/LC_MESSAGES/${name}.mo was not found")
+    endif()
+endforeach()
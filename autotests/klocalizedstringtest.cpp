@@ -8,6 +8,8 @@
 // Tests explicitly use their own test catalogs.
 #undef TRANSLATION_DOMAIN
 
+#include "config.h"
+
 #include "klocalizedstringtest.h"
 #include "klocalizedtranslator.h"
 
@@ -19,7 +21,9 @@
 #include <QTest>
 #include <QThread>
 
+#if HAVE_LIBINTL
 #include <libintl.h>
+#endif
 
 #include <klazylocalizedstring.h>
 #include <klocalizedstring.h>
@@ -28,6 +32,13 @@
 #include <QSet>
 #include <QString>
 
+#if HAVE_KTRANSCRIPT
+#include <QLibrary>
+#include <QPluginLoader>
+
+#include <ktranscript_p.h>
+#endif
+
 using namespace Qt::Literals;
 
 void initEnvironment()
@@ -145,6 +156,8 @@ void KLocalizedStringTest::correctSubs()
     QCOMPARE(i18n("%1 and %2", QString("Bowman"), QString("Poole")), QString("Bowman and Poole"));
     // Two placeholders in inverted order.
     QCOMPARE(i18n("%2 and %1", QString("Poole"), QString("Bowman")), QString("Bowman and Poole"));
+    // Same message again, substituted from the parsed translation.
+    QCOMPARE(i18n("%2 and %1", QString("Bowman"), QString("Poole")), QString("Poole and Bowman"));
 
     // % which is not of placeholder.
     QCOMPARE(i18n("It's going to go %1% failure in 72 hours.", 100), QString("It's going to go 100% failure in 72 hours."));
@@ -191,6 +204,8 @@ void KLocalizedStringTest::correctSubs()
     QCOMPARE(xi18nc("@info:shell", "E &lt; <emphasis>mc^2</emphasis>"), QString("E < *mc^2*"));
     QCOMPARE(xi18n("E = mc^&#x0032;"), QString("E = mc^2"));
     QCOMPARE(xi18n("E = mc^&#0050;"), QString("E = mc^2"));
+    QCOMPARE(xi18nc("@info", "Save &amp; <emphasis>&Quit</emphasis> &gt; \"now\""), QString("<html>Save &amp; <i>&amp;Quit</i> &gt; &quot;now&quot;</html>"));
+    QCOMPARE(xi18nc("@label", "<emphasis>&Quit</emphasis>&nbsp;&#x3c;"), QString::fromUtf8("*&Quit*\u00a0<"));
 
     // with additional whitespace
     QCOMPARE(xi18nc(" @info:progress ", "E &lt; <emphasis>mc^2</emphasis>"), QString("E < *mc^2*"));
@@ -348,6 +363,11 @@ void KLocalizedStringTest::setFormatForMarker()
     KuitSetup &setup = Kuit::setupForDomain(KLocalizedString::applicationDomain());
     setup.setFormatForMarker("@info:tooltip", Kuit::PlainText);
     QCOMPARE(xi18nc("@info:tooltip", "Hello world"), QString("Hello world"));
+
+    QCOMPARE(xi18nc("@info:tooltip", "Hello <emphasis>world</emphasis>"), QString("Hello *world*"));
+    setup.setTagPattern(QStringLiteral("emphasis"), QStringList(), Kuit::PlainText, ki18nc("tag-format-pattern <emphasis> plain", "_%1_"));
+    QCOMPARE(xi18nc("@info:tooltip", "Hello <emphasis>world</emphasis>"), QString("Hello _world_"));
+    setup.setTagPattern(QStringLiteral("emphasis"), QStringList(), Kuit::PlainText, ki18nc("tag-format-pattern <emphasis> plain", "*%1*"));
 }
 
 void KLocalizedStringTest::removeAcceleratorMarker()
@@ -391,6 +411,15 @@ void KLocalizedStringTest::miscMethods()
     KLocalizedString k;
     QVERIFY(k.isEmpty());
 
+    // Moved messages keep their arguments, moved-from ones can be assigned to.
+    KLocalizedString moved = ki18n("%1 and %2").subs(QString("Bowman")).subs(QString("Poole"));
+    KLocalizedString target(std::move(moved));
+    QCOMPARE(target.toString(), QString("Bowman and Poole"));
+    moved = target;
+    QCOMPARE(moved.toString(), QString("Bowman and Poole"));
+    k = std::move(moved);
+    QCOMPARE(k.toString(), QString("Bowman and Poole"));
+
     if (m_hasFrench) {
         QSet<QString> availableLanguages;
         availableLanguages.insert("fr");
@@ -410,11 +439,13 @@ void KLocalizedStringTest::translateToFrenchLowlevel()
         QSKIP("French test files not usable.");
     }
     QSKIP("Skipped by default to avoid changing global state.");
+#if HAVE_LIBINTL
     // fr_FR locale was set by initTestCase already.
     if (QFile::exists("/usr/share/locale/fr/LC_MESSAGES/ki18n-test.mo")) {
         bindtextdomain("ki18n-test", "/usr/share/locale");
         QCOMPARE(QString::fromUtf8(dgettext("ki18n-test", "Loadable modules")), QString::fromUtf8("Modules chargeables"));
     }
+#endif
 }
 
 void KLocalizedStringTest::translateToFrench()
@@ -524,6 +555,7 @@ void KLocalizedStringTest::brokenTags()
              QString("<html>Send bug reports to <email>konqi@kde.org<email>.</html>"));
 }
 
+#include <QElapsedTimer>
 #include <QFutureSynchronizer>
 #include <QThreadPool>
 #include <QtConcurrentRun>
@@ -540,6 +572,57 @@ void KLocalizedStringTest::testThreads()
     QThreadPool::globalInstance()->setMaxThreadCount(1); // delete those threads
 }
 
+void KLocalizedStringTest::benchmarkConcurrentTranslation_data()
+{
+    QTest::addColumn<int>("threadCount");
+
+    for (int threadCount = 1; threadCount < QThread::idealThreadCount(); threadCount *= 2) {
+        QTest::addRow("%d threads", threadCount) << threadCount;
+    }
+    QTest::addRow("%d threads", QThread::idealThreadCount()) << QThread::idealThreadCount();
+}
+
+void KLocalizedStringTest::benchmarkConcurrentTranslation()
+{
+    if (!m_hasFrench) {
+        QSKIP("French test files not usable.");
+    }
+    QFETCH(int, threadCount);
+
+    // Every thread does the same amount of work, so with translations
+    // running in parallel the elapsed time should stay about the same
+    // as threads are added.
+    const int iterations = 2000;
+    auto translate = [iterations]() {
+        int mismatches = 0;
+        for (int i = 0; i < iterations; ++i) {
+            mismatches += i18n("Job") != QString::fromUtf8("Tâche");
+            mismatches += i18n("Loadable modules") != QString::fromUtf8("Modules chargeables");
+            mismatches += i18n("Fault in %1 unit", QString("AE35")) != QString("Fault in AE35 unit");
+            mismatches += i18np("%1 pod", "%1 pods", i) != (i == 1 ? QString("1 pod") : QString("%1 pods").arg(i));
+        }
+        return mismatches;
+    };
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+    int mismatches = 0;
+    QElapsedTimer timer;
+    QBENCHMARK {
+        mismatches = 0;
+        timer.start();
+        QList<QFuture<int>> futures;
+        for (int i = 0; i < threadCount; ++i) {
+            futures.append(QtConcurrent::run(&pool, translate));
+        }
+        for (QFuture<int> &future : futures) {
+            mismatches += future.result();
+        }
+    }
+    QCOMPARE(mismatches, 0);
+    qDebug() << threadCount << "threads:" << (qint64(threadCount) * iterations * 4 * 1000) / qMax<qint64>(timer.elapsed(), 1) << "translations/s";
+}
+
 void KLocalizedStringTest::testLazy()
 {
     if (!m_hasFrench) {
@@ -548,6 +631,12 @@ void KLocalizedStringTest::testLazy()
     KLocalizedString s = kli18n("Job");
     KLocalizedString::setLanguages({"fr"});
     QCOMPARE(s.toString(), QString::fromUtf8("Tâche"));
+
+    static constexpr const KLazyLocalizedString table[] = {kli18n("Job"), kli18n("Loadable modules"), kli18n("Daisies, daisies")};
+    const QStringList expected{QString::fromUtf8("Tâche"), QStringLiteral("Modules chargeables"), QStringLiteral("Daisies, daisies")};
+    QCOMPARE(KLazyLocalizedString::toStringList(table), expected);
+    const QList<KLocalizedString> messages{ki18n("Job"), ki18n("Loadable modules"), ki18n("Daisies, daisies")};
+    QCOMPARE(KLocalizedString::toStringList(messages), expected);
     KLocalizedString::clearLanguages();
 }
 
@@ -570,6 +659,187 @@ void KLocalizedStringTest::testLanguageChange()
     QCOMPARE(i18n("Job"), "Job"_L1);
 }
 
+void KLocalizedStringTest::testScope()
+{
+    if (!m_hasFrench) {
+        QSKIP("French test files not usable.");
+    }
+    KLocalizedString::setLanguages({"en_US"});
+    {
+        KLocalizedScope scope({"fr"});
+        QCOMPARE(i18n("Job"), QString::fromUtf8("Tâche"));
+        QCOMPARE(KLocalizedString::languages(), QStringList{"en_US"});
+        {
+            KLocalizedScope inner({"en_US"});
+            QCOMPARE(i18n("Job"), QStringLiteral("Job"));
+        }
+        QCOMPARE(i18n("Job"), QString::fromUtf8("Tâche"));
+
+        // The scope does not leak into other threads.
+        const QString other = QtConcurrent::run([] {
+                                  return i18n("Job");
+                              }).result();
+        QCOMPARE(other, QStringLiteral("Job"));
+    }
+    QCOMPARE(i18n("Job"), QStringLiteral("Job"));
+    KLocalizedString::clearLanguages();
+}
+
+void KLocalizedStringTest::testTranslationCache()
+{
+    if (!m_hasFrench) {
+        QSKIP("French test files not usable.");
+    }
+
+    // Translations cached by the thread follow the set languages.
+    KLocalizedString::setLanguages({"fr"});
+    QCOMPARE(i18n("Job"), QString::fromUtf8("Tâche"));
+    KLocalizedString::setLanguages({"en_US"});
+    QCOMPARE(i18n("Job"), QStringLiteral("Job"));
+    KLocalizedString::setLanguages({"fr"});
+    QCOMPARE(i18n("Job"), QString::fromUtf8("Tâche"));
+
+    // And the languages and domain of scopes.
+    {
+        KLocalizedScope scope({"en_US"});
+        QCOMPARE(i18n("Job"), QStringLiteral("Job"));
+    }
+    QCOMPARE(i18n("Job"), QString::fromUtf8("Tâche"));
+    {
+        KLocalizedScope scope({}, "ki18n-test-qt");
+        QCOMPARE(i18n("Job"), QStringLiteral("Job"));
+    }
+    QCOMPARE(i18n("Job"), QString::fromUtf8("Tâche"));
+
+    // A hit gives the plural form for the number, whichever was cached.
+    for (int n : {33, 1, 2, 1}) {
+        QCOMPARE(i18ncp("%2 is the number of images", "Found %2 image in album %1", "Found %2 images in album %1", QString("AlbumName"), n),
+                 n == 1 ? QString("Trouvé an image dans l'album AlbumName") : QString("Plusiers images trouvées dans l'album AlbumName"));
+    }
+
+    // Domain locale directories added later are used, even for a domain
+    // whose translations were looked up before.
+    QTemporaryDir dir;
+    QVERIFY(QDir(dir.path()).mkpath("po"));
+    const QString poPath = dir.path() + "/po/ki18n-test-cache.po";
+    QVERIFY(QFile::copy(QFINDTESTDATA("po/fr/ki18n-test2.po"), poPath));
+    QCOMPARE(i18nd("ki18n-test-cache", "Cheese"), QStringLiteral("Cheese"));
+    QVERIFY(compileCatalogs({poPath}, dir.path(), "fr"));
+    KLocalizedString::addDomainLocaleDir("ki18n-test-cache", dir.path() + "/locale");
+    QCOMPARE(i18nd("ki18n-test-cache", "Cheese"), QString::fromUtf8("Fromage"));
+}
+
+void KLocalizedStringTest::testMarkupAfterSettingsChange()
+{
+    if (!m_hasFrench) {
+        QSKIP("French test files not usable.");
+    }
+    KLocalizedString::setLanguages({"fr"});
+    const QString before = kxi18n("<filename>a</filename>").toString(Kuit::PlainText);
+
+    // Tag patterns translated before are not kept once
+    // a catalog with other translations becomes available.
+    QTemporaryDir dir;
+    QVERIFY(QDir(dir.path()).mkpath("po"));
+    const QString poPath = dir.path() + "/po/ki18n6.po";
+    QFile poFile(poPath);
+    QVERIFY(poFile.open(QIODevice::WriteOnly));
+    poFile.write(
+        "msgid \"\"\n"
+        "msgstr \"\"\n"
+        "\"Content-Type: text/plain; charset=UTF-8\\n\"\n"
+        "\n"
+        "msgctxt \"tag-format-pattern <filename> plain\"\n"
+        "msgid \"‘%1’\"\n"
+        "msgstr \"[%1]\"\n");
+    poFile.close();
+    QVERIFY(compileCatalogs({poPath}, dir.path(), "fr"));
+    KLocalizedString::addDomainLocaleDir("ki18n6", dir.path() + "/locale");
+
+    QVERIFY(before != QStringLiteral("[a]"));
+    QCOMPARE(kxi18n("<filename>a</filename>").toString(Kuit::PlainText), QStringLiteral("[a]"));
+}
+
+#if HAVE_KTRANSCRIPT
+extern "C" {
+#if HAVE_STATIC_KTRANSCRIPT
+extern KTranscript *load_transcript();
+#else
+typedef KTranscript *(*InitFunc)();
+#endif
+}
+
+// The Transcript instance used by KLocalizedString.
+static KTranscript *transcriptInstance()
+{
+#if HAVE_STATIC_KTRANSCRIPT
+    return load_transcript();
+#else
+    // The same plugin as found by KLocalizedString, so the same instance.
+    QLibrary lib(QPluginLoader(QStringLiteral("kf6/ktranscript")).fileName());
+    if (!lib.load()) {
+        return nullptr;
+    }
+    InitFunc initf = (InitFunc)lib.resolve("load_transcript");
+    return initf ? initf() : nullptr;
+#endif
+}
+#endif
+
+void KLocalizedStringTest::testWarmUpTranscript()
+{
+    // None of the test languages has scripting modules, nothing to prepare.
+    QVERIFY(!KLocalizedString::warmUpTranscript());
+
+#if HAVE_KTRANSCRIPT
+    if (!m_hasFrench) {
+        QSKIP("French test files not usable.");
+    }
+
+    // A domain with a scripted translation and its scripting module,
+    // in the data directory of the test catalogs.
+    const QDir dataDir(m_tempDir.path());
+    const QString scriptDir = "locale/fr/LC_SCRIPTS/ki18n-test-script";
+    QVERIFY(dataDir.mkpath(scriptDir));
+    QFile module(dataDir.filePath(scriptDir + "/ki18n-test-script.js"));
+    QVERIFY(module.open(QIODevice::WriteOnly));
+    module.write(
+        "Ts.setcallForall(\"test_warmup_ready\", function() {});\n"
+        "Ts.setcall(\"test_warmup\", function(arg) {\n"
+        "    return arg + \" scripted\";\n"
+        "});\n");
+    module.close();
+
+    QTemporaryDir dir;
+    const QString poPath = dir.filePath("ki18n-test-script.po");
+    QFile poFile(poPath);
+    QVERIFY(poFile.open(QIODevice::WriteOnly));
+    poFile.write(
+        "msgid \"\"\n"
+        "msgstr \"\"\n"
+        "\"Content-Type: text/plain; charset=UTF-8\\n\"\n"
+        "\n"
+        "msgid \"Warm\"\n"
+        "msgstr \"Chaud|/|$[test_warmup Chaud]\"\n");
+    poFile.close();
+    QVERIFY(compileCatalogs({poPath}, dataDir, "fr"));
+
+    KTranscript *transcript = transcriptInstance();
+    QVERIFY(transcript);
+    QVERIFY(!transcript->postCalls("fr").contains("test_warmup_ready"));
+
+    // The domain of the scope is prepared, not the application domain.
+    KLocalizedScope scope({"fr"}, "ki18n-test-script");
+    QVERIFY(KLocalizedString::warmUpTranscript());
+
+    // The interpreter of this thread gets the module from the event loop,
+    // once the plugin and the modules have been located,
+    // before any translation is made.
+    QTRY_VERIFY(transcript->postCalls("fr").contains("test_warmup_ready"));
+    QCOMPARE(i18n("Warm"), QStringLiteral("Chaud scripted"));
+#endif
+}
+
 QTEST_MAIN(KLocalizedStringTest)
 
 #include "moc_klocalizedstringtest.cpp"
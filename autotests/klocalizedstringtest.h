@@ -25,6 +25,8 @@ private Q_SLOTS:
     void addCustomDomainPath();
 
     void testThreads();
+    void benchmarkConcurrentTranslation_data();
+    void benchmarkConcurrentTranslation();
 
     void testLocalizedTranslator();
     void semanticTags();
@@ -36,6 +38,10 @@ private Q_SLOTS:
 
     void testLazy();
     void testLanguageChange();
+    void testScope();
+    void testTranslationCache();
+    void testMarkupAfterSettingsChange();
+    void testWarmUpTranscript();
 
 private:
     bool m_hasFrench;
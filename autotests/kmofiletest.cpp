@@ -0,0 +1,201 @@
+/*
+    SPDX-FileCopyrightText: 2026 KDE Contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <kmofile_p.h>
+
+#include <QDebug>
+#include <QFile>
+#include <QProcess>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTest>
+
+// Key whose msgfmt hash carries out of the low 32 bits.
+static const QByteArray s_carryingKey("\xe7\xa3\xc4\xb0\xf4\xa4\xdf\xf9\xff");
+static constexpr int s_messageCount = 500;
+
+class KMoFileTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QVERIFY(m_tempDir.isValid());
+
+        // Catalog in Latin-1, so that the carrying key is a valid msgid.
+        QByteArray po;
+        po += "msgid \"\"\n"
+              "msgstr \"\"\n"
+              "\"Content-Type: text/plain; charset=ISO-8859-1\\n\"\n"
+              "\"Plural-Forms: nplurals=3; plural=n==1 ? 0 : n%10>=2 && n%10<=4 ? 1 : 2;\\n\"\n\n";
+        for (int i = 0; i < s_messageCount; ++i) {
+            po += "msgid \"message " + QByteArray::number(i) + "\"\n";
+            po += "msgstr \"translation " + QByteArray::number(i) + "\"\n\n";
+        }
+        po += "msgctxt \"context\"\nmsgid \"message 0\"\nmsgstr \"translation in context\"\n\n";
+        po += "msgid \"" + s_carryingKey + "\"\nmsgstr \"carried\"\n\n";
+        po += "msgid \"%1 file\"\nmsgid_plural \"%1 files\"\n"
+              "msgstr[0] \"one\"\nmsgstr[1] \"few\"\nmsgstr[2] \"many\"\n";
+
+        const QString poPath = m_tempDir.filePath(QStringLiteral("test.po"));
+        QFile poFile(poPath);
+        QVERIFY(poFile.open(QIODevice::WriteOnly));
+        poFile.write(po);
+        poFile.close();
+
+        const QString msgfmt = QStandardPaths::findExecutable(QStringLiteral("msgfmt"));
+        if (msgfmt.isEmpty()) {
+            qDebug() << "msgfmt(1) not found in path.";
+            return;
+        }
+        const QString moPath = m_tempDir.filePath(QStringLiteral("test.mo"));
+        QProcess process;
+        process.start(msgfmt, {poPath, QStringLiteral("-o"), moPath});
+        QVERIFY(process.waitForFinished(10000));
+        QCOMPARE(process.exitCode(), 0);
+
+        m_moFile.setFileName(moPath);
+        QVERIFY(m_moFile.open(QIODevice::ReadOnly));
+        const uchar *data = m_moFile.map(0, m_moFile.size());
+        QVERIFY(data);
+        m_catalog = std::make_unique<KMoFile>(data, m_moFile.size());
+        QVERIFY(m_catalog->isValid());
+        // msgfmt writes a hash table, which the lookups must go through.
+        QVERIFY(m_catalog->m_hashSize > 0);
+    }
+
+    void testTableHash()
+    {
+        // Values of hash_string() in Gettext.
+        QCOMPARE(KMoKeyHash(QByteArrayView(s_carryingKey)).table, 0x8fu);
+        QCOMPARE(KMoKeyHash(QByteArrayView("")).table, 0u);
+        QCOMPARE(KMoKeyHash(QByteArrayView("a")).table, 0x61u);
+        QCOMPARE(KMoKeyHash(QByteArray("c"), QByteArray("m")).table, KMoKeyHash(QByteArrayView("c\004m")).table);
+    }
+
+    void testCompileTimeHash()
+    {
+        // Hashing at compile time gives the same values as at runtime.
+        constexpr KMoKeyHash compileTime = [] {
+            KMoKeyHasher hasher;
+            hasher.add("context");
+            hasher.add('\004');
+            hasher.add("text");
+            return KMoKeyHash(hasher);
+        }();
+        const KMoKeyHash runtime(QByteArray("context"), QByteArray("text"));
+        QCOMPARE(compileTime.table, runtime.table);
+        QCOMPARE(compileTime.filter, runtime.filter);
+    }
+
+    void testLookup()
+    {
+        if (!m_catalog) {
+            QSKIP("Test catalog not compiled.");
+        }
+        for (int i = 0; i < s_messageCount; ++i) {
+            QCOMPARE(translate(QByteArray(), "message " + QByteArray::number(i)), "translation " + QByteArray::number(i));
+        }
+        QCOMPARE(translate("context", "message 0"), QByteArray("translation in context"));
+        QCOMPARE(translate(QByteArray(), s_carryingKey), QByteArray("carried"));
+        QVERIFY(translate(QByteArray(), "absent").isEmpty());
+        QVERIFY(translate("other", "message 0").isEmpty());
+    }
+
+    void testPlural()
+    {
+        if (!m_catalog) {
+            QSKIP("Test catalog not compiled.");
+        }
+        const QByteArray msgid("%1 file");
+        const KMoKeyHash hash(QByteArray(), msgid);
+        QCOMPARE(m_catalog->translate(QByteArray(), msgid, hash, 1).toByteArray(), QByteArray("one"));
+        QCOMPARE(m_catalog->translate(QByteArray(), msgid, hash, 3).toByteArray(), QByteArray("few"));
+        QCOMPARE(m_catalog->translate(QByteArray(), msgid, hash, 5).toByteArray(), QByteArray("many"));
+        QCOMPARE(m_catalog->translate(QByteArray(), msgid, hash, 22).toByteArray(), QByteArray("few"));
+    }
+
+    void testFilter()
+    {
+        if (!m_catalog) {
+            QSKIP("Test catalog not compiled.");
+        }
+        // Every key in the catalog passes the filter.
+        for (int i = 0; i < s_messageCount; ++i) {
+            QVERIFY(m_catalog->filterMayContain(KMoKeyHash(QByteArray(), "message " + QByteArray::number(i))));
+        }
+        QVERIFY(m_catalog->filterMayContain(KMoKeyHash(QByteArray(), "")));
+        QVERIFY(m_catalog->filterMayContain(KMoKeyHash("context", "message 0")));
+        QVERIFY(m_catalog->filterMayContain(KMoKeyHash(QByteArray(), s_carryingKey)));
+        QVERIFY(m_catalog->filterMayContain(KMoKeyHash(QByteArray(), "%1 file")));
+
+        // Nearly all absent keys are rejected, about 1% pass by design.
+        int passed = 0;
+        const int absentCount = 2000;
+        for (int i = 0; i < absentCount; ++i) {
+            if (m_catalog->filterMayContain(KMoKeyHash(QByteArray(), "absent " + QByteArray::number(i)))) {
+                ++passed;
+            }
+        }
+        QVERIFY2(passed < absentCount / 20, QByteArray::number(passed).constData());
+    }
+
+    void testPluralExpressionDepth()
+    {
+        // Pathological expressions are rejected instead of overflowing
+        // the stack, and the catalog falls back to Germanic plural.
+        const QList<QByteArray> expressions{
+            QByteArray(100000, '!') + "n",
+            QByteArray(100000, '(') + "n" + QByteArray(100000, ')'),
+            "n" + QByteArray("+n").repeated(100000),
+        };
+        for (const QByteArray &expression : expressions) {
+            QByteArray header = "Content-Type: text/plain; charset=UTF-8\nPlural-Forms: nplurals=2; plural=" + expression + ";\n";
+            const QByteArray mo = singleMessageCatalog("", header);
+            KMoFile catalog(reinterpret_cast<const uchar *>(mo.constData()), mo.size());
+            QVERIFY(catalog.isValid());
+            QCOMPARE(catalog.pluralForm(1), quint64(0));
+            QCOMPARE(catalog.pluralForm(2), quint64(1));
+        }
+    }
+
+private:
+    QByteArray translate(const QByteArray &msgctxt, const QByteArray &msgid) const
+    {
+        return m_catalog->translate(msgctxt, msgid, KMoKeyHash(msgctxt, msgid)).toByteArray();
+    }
+
+    // Catalog without hash table, holding only the given message.
+    static QByteArray singleMessageCatalog(const QByteArray &original, const QByteArray &translation)
+    {
+        QByteArray mo;
+        auto word = [&mo](quint32 value) {
+            mo.append(reinterpret_cast<const char *>(&value), 4);
+        };
+        const quint32 stringsOffset = 28 + 2 * 8;
+        word(0x950412de);
+        word(0);
+        word(1);
+        word(28);
+        word(28 + 8);
+        word(0);
+        word(0);
+        word(original.size());
+        word(stringsOffset);
+        word(translation.size());
+        word(stringsOffset + original.size() + 1);
+        mo += original + '\0' + translation + '\0';
+        return mo;
+    }
+
+    QTemporaryDir m_tempDir;
+    QFile m_moFile;
+    std::unique_ptr<KMoFile> m_catalog;
+};
+
+QTEST_GUILESS_MAIN(KMoFileTest)
+
+#include "kmofiletest.moc"
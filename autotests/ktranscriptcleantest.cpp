@@ -8,7 +8,11 @@
 
 #include <QTest>
 
+#include <QDateTime>
 #include <QDebug>
+#include <QFile>
+#include <QProcess>
+#include <QTemporaryDir>
 
 #include <ktranscript_p.h>
 KTranscript *autotestCreateKTranscriptImp();
@@ -80,4 +84,165 @@ void KTranscriptCleanTest::test()
     }
 }
 
+void KTranscriptCleanTest::testPureCall()
+{
+    QString testJs = QFINDTESTDATA("test.js");
+    QHash<QString, QString> dynamicContext;
+    QStringList subs;
+    QList<QVariant> values;
+    QString error;
+    bool fallback;
+
+    QList<QStringList> modules;
+    modules << (QStringList() << testJs << "fr");
+    QString result = m_transcript->eval({"test_pure", "foo"}, "fr", "fr", "", dynamicContext, "", subs, values, "", modules, error, fallback);
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+    QCOMPARE(result, "foo 1");
+
+    // The function is not called again for the same arguments.
+    result = m_transcript->eval({"test_pure", "foo"}, "fr", "fr", "", dynamicContext, "", subs, values, "", modules, error, fallback);
+    QCOMPARE(result, "foo 1");
+    result = m_transcript->eval({"test_pure", "bar"}, "fr", "fr", "", dynamicContext, "", subs, values, "", modules, error, fallback);
+    QCOMPARE(result, "bar 2");
+    result = m_transcript->eval({"test_pure", 5}, "fr", "fr", "", dynamicContext, "", subs, values, "", modules, error, fallback);
+    QCOMPARE(result, "5 3");
+    result = m_transcript->eval({"test_pure", "5"}, "fr", "fr", "", dynamicContext, "", subs, values, "", modules, error, fallback);
+    QCOMPARE(result, "5 4");
+
+    // Results depending on properties are not kept once they may change.
+    result = m_transcript->eval({"test_pureProp", "Athens", "gen"}, "fr", "fr", "", dynamicContext, "", subs, values, "", modules, error, fallback);
+    QCOMPARE(result, "undefined 5");
+    result = m_transcript->eval({"test_loadProps", "cities"}, "fr", "fr", "", dynamicContext, "", subs, values, "", modules, error, fallback);
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+    result = m_transcript->eval({"test_pureProp", "Athens", "gen"}, "fr", "fr", "", dynamicContext, "", subs, values, "", modules, error, fallback);
+    QCOMPARE(result, "Atine 6");
+    result = m_transcript->eval({"test_pureProp", "Athens", "gen"}, "fr", "fr", "", dynamicContext, "", subs, values, "", modules, error, fallback);
+    QCOMPARE(result, "Atine 6");
+    result = m_transcript->eval({"test_setProp", "Athens", "gen", "Atene"}, "fr", "fr", "", dynamicContext, "", subs, values, "", modules, error, fallback);
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+    result = m_transcript->eval({"test_pureProp", "Athens", "gen"}, "fr", "fr", "", dynamicContext, "", subs, values, "", modules, error, fallback);
+    QCOMPARE(result, "Atene 7");
+}
+
+void KTranscriptCleanTest::testCompiledPropertyMaps()
+{
+    // The maps must be next to the module loading them.
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString testJs = dir.filePath("test.js");
+    QVERIFY(QFile::copy(QFINDTESTDATA("test.js"), testJs));
+
+    auto writeMap = [&dir](const QString &name, const QByteArray &text) {
+        QFile file(dir.filePath(name + ".pmap"));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(text);
+    };
+    auto compileMap = [&dir](const QString &name, const QString &format) {
+        const QString input = dir.filePath(name + ".pmap");
+        const QString output = dir.filePath(name + ".pmapc");
+        QStringList arguments;
+        if (format == "01") {
+            // Maps in the previous format can only be written from the module.
+            arguments << "-c"
+                      << "import runpy, sys; m = runpy.run_path(sys.argv[1]); "
+                         "m['write_map_bin_01'](open(sys.argv[3], 'wb'), m['read_pmap'](sys.argv[2]))";
+        }
+        arguments << PMAP_COMPILE_SCRIPT << input << output;
+        QProcess process;
+        process.start(PYTHON_EXECUTABLE, arguments);
+        QVERIFY(process.waitForFinished(10000));
+        QVERIFY2(process.exitCode() == 0, process.readAllStandardError().constData());
+        QVERIFY(QFile::remove(input));
+    };
+
+    writeMap("old", "=:Athens:gen=Old::\n=:Nowhere:gen=Old::\n=:Paris:gen=Old::\n");
+    compileMap("old", "01");
+    writeMap("new", "=:Athens:gen=New::\n=:Nowhere::\n=:Rome:Roma:gen=New::\n");
+    compileMap("new", "02");
+    writeMap("text", "=:Athens:gen=Text::\n");
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+
+    QHash<QString, QString> dynamicContext;
+    QStringList subs;
+    QList<QVariant> values;
+    QString error;
+    bool fallback;
+    QList<QStringList> modules;
+    modules << (QStringList() << testJs << "fr") << (QStringList() << testJs << "de");
+
+    auto getProp = [&](const QString &language, const QString &map, const QString &phrase) {
+        return m_transcript->eval({"test_getProp", map, phrase, "gen"}, language, language, "", dynamicContext, "", subs, values, "", modules, error, fallback);
+    };
+
+    // The map loaded last takes precedence, whatever its format,
+    // also when it has the phrase with no properties.
+    QCOMPARE(getProp("fr", "old", "Paris"), "Old");
+    QCOMPARE(getProp("fr", "new", "Athens"), "New");
+    QCOMPARE(getProp("fr", "new", "Roma"), "New");
+    QCOMPARE(getProp("fr", "new", "Paris"), "Old");
+    QCOMPARE(getProp("fr", "text", "Athens"), "Text");
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+    getProp("fr", "new", "Nowhere");
+    QCOMPARE(error, "Non-string return value: undefined");
+
+    QCOMPARE(getProp("de", "new", "Athens"), "New");
+    QCOMPARE(getProp("de", "old", "Athens"), "Old");
+    QCOMPARE(getProp("de", "old", "Nowhere"), "Old");
+    QCOMPARE(getProp("de", "old", "Rome"), "New");
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+}
+
+void KTranscriptCleanTest::testModuleSourceCache()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString moduleJs = dir.filePath("cached.js");
+    const QDateTime firstModified = QDateTime::currentDateTimeUtc().addSecs(-60);
+
+    auto writeModule = [&moduleJs](const QByteArray &result, const QDateTime &lastModified) {
+        QFile file(moduleJs);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("Ts.setcall(\"test_cached\", function() {\n"
+                   "    return \""
+                   + result
+                   + "\";\n"
+                     "});\n");
+        QVERIFY(file.flush());
+        QVERIFY(file.setFileTime(lastModified, QFileDevice::FileModificationTime));
+    };
+
+    QHash<QString, QString> dynamicContext;
+    QStringList subs;
+    QList<QVariant> values;
+    QString error;
+    bool fallback;
+    QList<QStringList> modules;
+    auto evalCached = [&]() {
+        modules = {{moduleJs, "fr"}};
+        return m_transcript->eval({"test_cached"}, "fr", "fr", "", dynamicContext, "", subs, values, "", modules, error, fallback);
+    };
+    // Interpreters made anew, which load the module again.
+    auto recreate = [this]() {
+        autotestDestroyKTranscriptImp();
+        m_transcript = autotestCreateKTranscriptImp();
+    };
+
+    writeModule("first", firstModified);
+    QCOMPARE(evalCached(), "first");
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+
+    // The source read before is used while the file keeps its modification time.
+    writeModule("unread", firstModified);
+    recreate();
+    QCOMPARE(evalCached(), "first");
+
+    // And read again once it has changed.
+    writeModule("second", firstModified.addSecs(30));
+    recreate();
+    QCOMPARE(evalCached(), "second");
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+}
+
 #include "moc_ktranscriptcleantest.cpp"
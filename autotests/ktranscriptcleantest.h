@@ -38,6 +38,10 @@ private Q_SLOTS:
     void test_data();
     void test();
 
+    void testPureCall();
+    void testCompiledPropertyMaps();
+    void testModuleSourceCache();
+
 private:
     QLibrary m_library;
     KTranscript *m_transcript;
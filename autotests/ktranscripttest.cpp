@@ -15,6 +15,7 @@
 #include <QTest>
 
 #include <QDebug>
+#include <QThread>
 
 #include <ktranscript_p.h>
 
@@ -134,4 +135,52 @@ void KTranscriptTest::test()
     }
 }
 
+void KTranscriptTest::testThreads()
+{
+    // Scripted translations evaluated in other threads, at the same time,
+    // by interpreters which each thread sets up for itself.
+    const QString testJs = QFINDTESTDATA("test.js");
+    const int threadCount = 4;
+    QList<QString> results(threadCount);
+    QList<QString> props(threadCount);
+    QList<QString> errors(threadCount);
+    QList<QThread *> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        threads.append(QThread::create([this, i, testJs, &results, &props, &errors]() {
+            QHash<QString, QString> dynamicContext;
+            QList<QStringList> modules;
+            modules << (QStringList() << testJs << "fr");
+            bool fallback;
+            results[i] = m_transcript->eval({"test_acall", "test_basic", QString::number(i)},
+                                            "fr",
+                                            "fr",
+                                            "",
+                                            dynamicContext,
+                                            "",
+                                            {},
+                                            {},
+                                            "",
+                                            modules,
+                                            errors[i],
+                                            fallback);
+            if (errors[i].isEmpty()) {
+                props[i] = m_transcript->eval({"test_getProp", "cities", "Paris", "dat"}, "fr", "fr", "", dynamicContext, "", {}, {}, "", modules, errors[i], fallback);
+            }
+        }));
+    }
+    for (QThread *thread : std::as_const(threads)) {
+        thread->start();
+    }
+    for (QThread *thread : std::as_const(threads)) {
+        thread->wait();
+        delete thread;
+    }
+
+    for (int i = 0; i < threadCount; ++i) {
+        QVERIFY2(errors[i].isEmpty(), qPrintable(errors[i]));
+        QCOMPARE(results[i], QString::number(i) + " bar");
+        QCOMPARE(props[i], "Parizu");
+    }
+}
+
 #include "moc_ktranscripttest.cpp"
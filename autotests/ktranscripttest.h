@@ -36,6 +36,8 @@ private Q_SLOTS:
     void test_data();
     void test();
 
+    void testThreads();
+
 private:
     QLibrary m_library;
     KTranscript *m_transcript;
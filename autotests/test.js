@@ -123,3 +123,14 @@ Ts.setcall("test_getConfNumber", function(key) {
 Ts.setcall("test_getConfNumberWithDefault", function(key, defValue) {
     return "" + Ts.getConfNumber(key, defValue);
 });
+
+var pureCalls = 0;
+Ts.setcall("test_pure", function(arg) {
+    ++pureCalls;
+    return arg + " " + pureCalls;
+}, null, true);
+
+Ts.setcall("test_pureProp", function(phrase, prop) {
+    ++pureCalls;
+    return Ts.getProp(phrase, prop) + " " + pureCalls;
+}, null, true);
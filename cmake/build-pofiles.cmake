@@ -40,6 +40,11 @@ foreach(pofile IN LISTS pofiles)
     endif()
 
     list(APPEND commands COMMAND ${GETTEXT_MSGFMT_EXECUTABLE} -o ${dest}/${name}.mo ${PO_DIR}/${pofile})
+    # Report broken KUIT markup in translations, which would otherwise
+    # only show up at runtime.
+    if(_ki18n_kuit_check_script AND _ki18n_kuit_check_python)
+        list(APPEND commands COMMAND ${_ki18n_kuit_check_python} -B ${_ki18n_kuit_check_script} ${PO_DIR}/${pofile})
+    endif()
     math(EXPR i "${i}+1")
     if(i EQUAL ${numberOfProcesses})
         _processCommands()
@@ -0,0 +1,344 @@
+# -*- coding: UTF-8 -*-
+
+# Script that checks KUIT markup in translations of a PO file.
+# Translations whose markup is broken are shown at runtime with the markup
+# salvaged as well as possible, so the checks report them at build time.
+# Only translations of messages whose original text contains markup,
+# which is well-formed, are checked.
+# https://api.kde.org/frameworks/ki18n/html/prg_guide.html#kuit_markup
+#
+# The checks only warn, problems with the PO file itself are left
+# to msgfmt, so the script always exits successfully.
+#
+# Usage:
+#   kuit-check.py file.po
+#
+# Works with Python >= 3.0.
+
+import codecs
+import os
+import re
+import sys
+import unicodedata
+
+
+cmdname = os.path.basename(sys.argv[0])
+
+class PoError (Exception):
+    pass
+
+
+def warning (msg):
+    sys.stderr.write("%s: warning: %s\n" % (cmdname, msg))
+
+
+def unescape_po (text):
+
+    escapes = {"n": "\n", "t": "\t", "r": "\r", "\"": "\"", "\\": "\\"}
+    chars = []
+    i = 0
+    while i < len(text):
+        c = text[i]
+        if c == "\\" and i + 1 < len(text):
+            i += 1
+            c = escapes.get(text[i], text[i])
+        chars.append(c)
+        i += 1
+    return "".join(chars)
+
+
+def po_encoding (data):
+
+    # Encoding declared in the header, UTF-8 if none or unknown.
+    # Encodings allowed in PO files are ASCII-compatible,
+    # so the header can be searched in the raw data.
+    match = re.search(br"charset=([A-Za-z0-9_.:-]+)", data)
+    if match:
+        try:
+            return codecs.lookup(match.group(1).decode("ascii")).name
+        except LookupError:
+            pass
+    return "utf-8"
+
+
+def read_po (fname):
+
+    # Returns (line number, msgid, [msgstr, ...]) for each message
+    # which is translated, not fuzzy and not obsolete.
+
+    fh = open(fname, "rb")
+    data = fh.read()
+    fh.close()
+    text = data.decode(po_encoding(data), "replace")
+    lines = [l.strip() for l in text.splitlines()]
+
+    messages = []
+    entry = {"fuzzy": False}
+
+    def flush ():
+        msgstrs = [entry[k] for k in sorted(k for k in entry
+                                            if k[0] == "msgstr")]
+        msgstrs = [v for v in msgstrs if v]
+        if entry.get(("msgid", 0)) and msgstrs and not entry["fuzzy"]:
+            messages.append((entry["line"], entry[("msgid", 0)], msgstrs))
+
+    field = None
+    for i, line in enumerate(lines):
+        if not line or line.startswith("#~"):
+            continue
+
+        if line.startswith("\""):
+            if field is None:
+                raise PoError("unexpected string at %s:%d" % (fname, i + 1))
+            entry[field] += unescape_po(line[1:-1])
+            continue
+
+        # A comment or a message key after translations starts a new entry.
+        starts_entry = line.startswith("#") or line.startswith("msgctxt ") \
+                       or line.startswith("msgid ")
+        if starts_entry and field is not None and field[0] == "msgstr":
+            flush()
+            entry = {"fuzzy": False}
+            field = None
+
+        if line.startswith("domain "):
+            # Messages of another domain follow, check them all the same.
+            field = None
+            continue
+
+        if line.startswith("#"):
+            if line.startswith("#,"):
+                flags = [f.strip() for f in line[2:].split(",")]
+                entry["fuzzy"] = entry["fuzzy"] or "fuzzy" in flags
+            continue
+
+        keyword, sep, value = line.partition(" ")
+        if keyword.startswith("msgstr["):
+            field = ("msgstr", int(keyword[7:-1]))
+        elif keyword in ("msgctxt", "msgid", "msgid_plural", "msgstr"):
+            field = (keyword, 0)
+        else:
+            raise PoError("unknown keyword '%s' at %s:%d"
+                          % (keyword, fname, i + 1))
+        if keyword == "msgid":
+            entry["line"] = i + 1
+        entry[field] = unescape_po(value.strip()[1:-1])
+
+    if field is not None:
+        flush()
+
+    return messages
+
+
+def is_name_start_char (c):
+    return c.isalpha() or c in "_:"
+
+
+def is_name_char (c):
+    return (c.isalnum() or unicodedata.category(c).startswith("M")
+            or c in "_:-.")
+
+
+def is_xml_char (code):
+    return (code in (0x9, 0xa, 0xd) or 0x20 <= code <= 0xd7ff
+            or 0xe000 <= code <= 0xfffd or 0x10000 <= code <= 0x10ffff)
+
+
+named_entities = ("lt", "gt", "amp", "apos", "quot", "nbsp")
+
+
+def check_entity (text, i):
+
+    # Must do the same as readEntity() in ki18n/src/i18n/kuitsetup.cpp:
+    # an ampersand which does not start an entity is a shortcut marker.
+    # Returns the position after the entity or the ampersand,
+    # or None if the entity is not known or not a valid character.
+    end = i + 1
+    numeric = text.startswith("#", end)
+    hexadecimal = numeric and text.startswith("x", end + 1)
+    end += numeric + hexadecimal
+    start = end
+    if hexadecimal:
+        valid = "0123456789abcdefABCDEF"
+    elif numeric:
+        valid = "0123456789"
+    else:
+        valid = "abcdefghijklmnopqrstuvwxyz"
+    while end < len(text) and text[end] in valid:
+        end += 1
+    if end == start or end == len(text) or text[end] != ";":
+        return i + 1
+    if numeric:
+        code = int(text[start:end], 16 if hexadecimal else 10)
+        if not is_xml_char(code):
+            return None
+    elif text[start:end] not in named_entities:
+        return None
+    return end + 1
+
+
+def read_name (text, i):
+
+    if i >= len(text) or not is_name_start_char(text[i]):
+        return None, i
+    end = i + 1
+    while end < len(text) and is_name_char(text[end]):
+        end += 1
+    return text[i:end], end
+
+
+def skip_whitespace (text, i):
+
+    while i < len(text) and text[i] in " \n\t\r":
+        i += 1
+    return i
+
+
+def check_markup (text):
+
+    # Must accept the same as KuitTokenizer in ki18n/src/i18n/kuitsetup.cpp.
+    # Returns the description of the first error, and whether
+    # there is any markup at all, as (error, has markup).
+    open_elements = []
+    has_markup = False
+    i = 0
+    n = len(text)
+    while i < n:
+        c = text[i]
+        if c == "<":
+            has_markup = True
+            if text.startswith("<!--", i):
+                end = text.find("-->", i + 4)
+                if end < 0:
+                    return "unterminated comment", has_markup
+                i = end + 3
+            elif text.startswith("<?", i):
+                end = text.find("?>", i + 2)
+                if end < 0:
+                    return "unterminated processing instruction", has_markup
+                i = end + 2
+            elif text.startswith("<![CDATA[", i):
+                end = text.find("]]>", i + 9)
+                if end < 0:
+                    return "unterminated CDATA section", has_markup
+                i = end + 3
+            elif text.startswith("</", i):
+                name, i = read_name(text, i + 2)
+                if name is None:
+                    return "expected element name", has_markup
+                i = skip_whitespace(text, i)
+                if not text.startswith(">", i):
+                    return "expected '>' after element name", has_markup
+                i += 1
+                if not open_elements or open_elements[-1] != name:
+                    return ("closing tag '%s' does not match the opening tag"
+                            % name), has_markup
+                open_elements.pop()
+            else:
+                name, i = read_name(text, i + 1)
+                if name is None:
+                    return "expected element name", has_markup
+                attribute_names = []
+                while True:
+                    separated = i < n and text[i] in " \n\t\r"
+                    i = skip_whitespace(text, i)
+                    if text.startswith(">", i):
+                        open_elements.append(name)
+                        i += 1
+                        break
+                    elif text.startswith("/", i):
+                        if not text.startswith("/>", i):
+                            return "expected '>' after '/'", has_markup
+                        i += 2
+                        break
+                    elif i >= n:
+                        return ("premature end of message in element '%s'"
+                                % name), has_markup
+                    elif not separated:
+                        return "expected whitespace before attribute", has_markup
+                    attribute, i = read_name(text, i)
+                    if attribute is None:
+                        return "expected attribute name", has_markup
+                    if attribute in attribute_names:
+                        return ("attribute '%s' redefined"
+                                % attribute), has_markup
+                    attribute_names.append(attribute)
+                    i = skip_whitespace(text, i)
+                    if not text.startswith("=", i):
+                        return ("expected '=' after attribute name"), has_markup
+                    i = skip_whitespace(text, i + 1)
+                    if i >= n or text[i] not in "'\"":
+                        return "expected quoted attribute value", has_markup
+                    quote = text[i]
+                    i += 1
+                    while True:
+                        if i >= n:
+                            return ("premature end of message "
+                                    "in attribute value"), has_markup
+                        v = text[i]
+                        if v == quote:
+                            i += 1
+                            break
+                        elif v == "<":
+                            return "character '<' in attribute value", has_markup
+                        elif v == "&":
+                            i = check_entity(text, i)
+                            if i is None:
+                                return "unknown or invalid entity", has_markup
+                        elif not is_xml_char(ord(v)):
+                            return ("invalid character in attribute value",
+                                    has_markup)
+                        else:
+                            i += 1
+        elif c == "&":
+            end = check_entity(text, i)
+            if end is None:
+                return "unknown or invalid entity", has_markup
+            has_markup = has_markup or end > i + 1
+            i = end
+        elif c == ">" and text.endswith("]]", 0, i):
+            return "sequence ']]>' not allowed in content", has_markup
+        elif not is_xml_char(ord(c)):
+            return "invalid character", has_markup
+        else:
+            i += 1
+
+    if open_elements:
+        return "element '%s' is not closed" % open_elements[-1], has_markup
+    return None, has_markup
+
+
+def main ():
+
+    if sys.version_info[0] < 3:
+        warning("Python 3 is needed, KUIT markup is not checked")
+        return
+
+    if len(sys.argv) != 2:
+        warning("usage: %s FILE.po" % cmdname)
+        return
+
+    fname = sys.argv[1]
+    try:
+        messages = read_po(fname)
+    except (IOError, PoError) as e:
+        warning("cannot check KUIT markup in %s: %s" % (fname, e))
+        return
+
+    for lineno, msgid, msgstrs in messages:
+        err, has_markup = check_markup(msgid)
+        if err or not has_markup:
+            continue
+        for msgstr in msgstrs:
+            err, has_markup = check_markup(msgstr)
+            if err:
+                warning("broken KUIT markup in translation at %s:%d: %s"
+                        % (fname, lineno, err))
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except Exception as e:
+        warning("KUIT markup check failed: %s" % e)
+    sys.exit(0)
@@ -273,6 +273,77 @@ def write_map_bin_01 (fh, pmap):
         fh.write(cbinprops)
 
 
+# Hash of phrase key for the index of binary map format 02 (32-bit FNV-1a).
+# Must do the same as pmap02KeyHash() in ki18n/src/i18n/ktranscript.cpp.
+def key_hash (key):
+    h = 0x811c9dc5
+    for b in bytearray(key.encode("utf8")):
+        h = ((h ^ b) * 0x01000193) & 0xffffffff
+    return h
+
+
+# Binary map format 02.
+# Same as 01, except that entry keys are preceded by an index
+# of slots by key hash, so that the map can be used memory mapped,
+# without reading in the entry keys.
+def write_map_bin_02 (fh, pmap):
+
+    binint32len = len(int_bin_32(0))
+    binint64len = len(int_bin_64(0))
+    slotlen = binint32len + binint64len
+
+    # Entry of each key, where later entries take precedence.
+    ekey_entries = {}
+    for i, (ekeys, d1) in enumerate(pmap):
+        for ekey in ekeys:
+            ekey_entries[ekey] = i
+    allekeys = sorted(ekey_entries)
+
+    # Index is at most half full, so that probing stays short.
+    nslots = 2 * len(allekeys) + 1
+    offset0 = len("TSPMAP02") + binint32len + nslots * slotlen
+
+    # Offsets of entry keys, and of property blobs after them.
+    ekey_offsets = []
+    eoffset = offset0
+    for ekey in allekeys:
+        ekey_offsets.append(eoffset)
+        eoffset += len(str_bin_32(ekey)) + binint64len
+
+    binprops = []
+    poffsets = []
+    poffset = eoffset
+    for d1, props in pmap:
+        cbinprops = catb(sum([list(map(str_bin_32, x)) for x in props], []))
+        cbinprops = catb([int_bin_32(len(props)), int_bin_32(len(cbinprops)),
+                          cbinprops])
+        binprops.append(cbinprops)
+        poffsets.append(poffset)
+        poffset += len(cbinprops)
+
+    # Place keys into slots by hash, probing linearly.
+    slots = [None] * nslots
+    for ekey, eoffset in zip(allekeys, ekey_offsets):
+        h = key_hash(ekey)
+        j = h % nslots
+        while slots[j] is not None:
+            j = (j + 1) % nslots
+        slots[j] = (h, eoffset)
+
+    # Write everything out.
+    fh.write("TSPMAP02".encode("ascii"))
+    fh.write(int_bin_32(nslots))
+    for slot in slots:
+        h, eoffset = slot if slot is not None else (0, 0)
+        fh.write(struct.pack(">I", h))
+        fh.write(int_bin_64(eoffset))
+    for ekey in allekeys:
+        fh.write(str_bin_32(ekey))
+        fh.write(int_bin_64(poffsets[ekey_entries[ekey]]))
+    for cbinprops in binprops:
+        fh.write(cbinprops)
+
+
 def main ():
 
     if len(sys.argv) != 3:
@@ -289,7 +360,7 @@ def main ():
 
     pmap = read_pmap(ifile)
     ofh = open(ofile, "wb")
-    write_map_bin_01(ofh, pmap)
+    write_map_bin_02(ofh, pmap)
     ofh.close()
 
 
@@ -8,11 +8,11 @@
 #include "config.h"
 
 #include <kcatalog_p.h>
+#include <kmofile_p.h>
 
 #include "ki18n_logging.h"
 
 #include <QByteArray>
-#include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
 #include <QFile>
@@ -20,6 +20,7 @@
 #include <QMutexLocker>
 #include <QSet>
 #include <QStandardPaths>
+#include <QStringDecoder>
 #include <QStringList>
 
 #ifdef Q_OS_ANDROID
@@ -28,46 +29,8 @@
 
 #include <android/asset_manager.h>
 #include <android/asset_manager_jni.h>
-
-#if __ANDROID_API__ < 23
-#include <dlfcn.h>
-#endif
-#endif
-
-#include <cerrno>
-#include <cstdio>
-#include <cstring>
-#include <locale.h>
-#include <stdlib.h>
-
-#include "gettext.h" // Must be included after <stdlib.h>
-
-// not defined on win32 :(
-#ifdef _WIN32
-#ifndef LC_MESSAGES
-#define LC_MESSAGES 42
-#endif
 #endif
 
-#if HAVE_NL_MSG_CAT_CNTR
-extern "C" int Q_DECL_IMPORT _nl_msg_cat_cntr;
-#endif
-
-static char *s_langenv = nullptr;
-static const int s_langenvMaxlen = 64;
-// = "LANGUAGE=" + 54 chars for language code + terminating null \0 character
-
-static void copyToLangArr(const QByteArray &lang)
-{
-    const int bytes = std::snprintf(s_langenv, s_langenvMaxlen, "LANGUAGE=%s", lang.constData());
-    if (bytes < 0) {
-        qCWarning(KI18N) << "There was an error while writing LANGUAGE environment variable:" << std::strerror(errno);
-    } else if (bytes > (s_langenvMaxlen - 1)) { // -1 for the \0 character
-        qCWarning(KI18N) << "The value of the LANGUAGE environment variable:" << lang << "( size:" << lang.size() << "),\n"
-                         << "was longer than (and consequently truncated to) the max. length of:" << (s_langenvMaxlen - strlen("LANGUAGE=") - 1);
-    }
-}
-
 class KCatalogStaticData
 {
 public:
@@ -78,10 +41,6 @@ public:
         QJniObject context = QNativeInterface::QAndroidApplication::context();
         m_assets = context.callObjectMethod("getAssets", "()Landroid/content/res/AssetManager;");
         m_assetMgr = AAssetManager_fromJava(env.jniEnv(), m_assets.object());
-
-#if __ANDROID_API__ < 23
-        fmemopenFunc = reinterpret_cast<decltype(fmemopenFunc)>(dlsym(RTLD_DEFAULT, "fmemopen"));
-#endif
 #endif
     }
 
@@ -91,9 +50,6 @@ public:
 #ifdef Q_OS_ANDROID
     QJniObject m_assets;
     AAssetManager *m_assetMgr = nullptr;
-#if __ANDROID_API__ < 23
-    FILE *(*fmemopenFunc)(void *, size_t, const char *);
-#endif
 #endif
 };
 
@@ -102,27 +58,99 @@ Q_GLOBAL_STATIC(KCatalogStaticData, catalogStaticData)
 class KCatalogPrivate
 {
 public:
-    KCatalogPrivate();
+    KCatalogPrivate() = default;
+    ~KCatalogPrivate();
 
     QByteArray domain;
     QByteArray language;
     QByteArray localeDir;
 
-    QByteArray systemLanguage;
-    bool bindDone;
+    // Backing store of the catalog data, a file mapping if possible.
+    QFile moFile;
+    QByteArray moData;
+#ifdef Q_OS_ANDROID
+    AAsset *moAsset = nullptr;
+#endif
 
-    static QByteArray currentLanguage;
+    std::unique_ptr<KMoFile> mo;
+    bool isUtf8 = true;
 
-    void setupGettextEnv();
-    void resetSystemLanguage();
+    void loadCatalog();
+    QString decode(QByteArrayView msgstr) const;
 };
 
-KCatalogPrivate::KCatalogPrivate()
-    : bindDone(false)
+KCatalogPrivate::~KCatalogPrivate()
 {
+    // The catalog must go before the data it refers to.
+    mo.reset();
+#ifdef Q_OS_ANDROID
+    if (moAsset) {
+        AAsset_close(moAsset);
+    }
+#endif
+}
+
+void KCatalogPrivate::loadCatalog()
+{
+    const uchar *data = nullptr;
+    qsizetype size = 0;
+
+#ifdef Q_OS_ANDROID
+    // On Android the locale directory is the path of the catalog itself.
+    const QString moPath = QFile::decodeName(localeDir);
+    if (localeDir.startsWith("assets:/")) {
+        moAsset = AAssetManager_open(catalogStaticData->m_assetMgr, localeDir.mid(8).constData(), AASSET_MODE_BUFFER);
+        if (!moAsset) {
+            qCWarning(KI18N) << "unable to load asset" << localeDir;
+            return;
+        }
+        data = static_cast<const uchar *>(AAsset_getBuffer(moAsset));
+        size = AAsset_getLength64(moAsset);
+    }
+#else
+    const QString moPath = QFile::decodeName(localeDir + '/' + language + "/LC_MESSAGES/" + domain + ".mo");
+#endif
+
+    if (!data) {
+        moFile.setFileName(moPath);
+        if (!moFile.open(QIODevice::ReadOnly)) {
+            qCWarning(KI18N) << "Cannot open catalog" << moPath << moFile.errorString();
+            return;
+        }
+        size = moFile.size();
+        data = moFile.map(0, size);
+        if (!data) {
+            // Not all file systems support mapping, fall back to reading.
+            moData = moFile.readAll();
+            moFile.close();
+            data = reinterpret_cast<const uchar *>(moData.constData());
+            size = moData.size();
+        }
+    }
+
+    mo = std::make_unique<KMoFile>(data, size);
+    if (!mo->isValid()) {
+        qCWarning(KI18N) << "Invalid catalog" << moPath;
+        mo.reset();
+        return;
+    }
+
+    const QByteArray charset = mo->charset().toLower();
+    isUtf8 = charset.isEmpty() || charset == "utf-8" || charset == "utf8" || charset == "ascii" || charset == "us-ascii";
 }
 
-QByteArray KCatalogPrivate::currentLanguage;
+QString KCatalogPrivate::decode(QByteArrayView msgstr) const
+{
+    if (msgstr.isEmpty()) {
+        return QString();
+    }
+    if (isUtf8) {
+        return QString::fromUtf8(msgstr);
+    }
+    // Always give translations in UTF-8, regardless of the catalog encoding.
+    QStringDecoder decoder(mo->charset().constData());
+    return decoder.isValid() ? QString(decoder(msgstr)) : QString::fromUtf8(msgstr);
+}
 
 KCatalog::KCatalog(const QByteArray &domain, const QString &language_)
     : d(new KCatalogPrivate)
@@ -132,54 +160,12 @@ KCatalog::KCatalog(const QByteArray &domain, const QString &language_)
     d->localeDir = QFile::encodeName(catalogLocaleDir(domain, language_));
 
     if (!d->localeDir.isEmpty()) {
-        // Always get translations in UTF-8, regardless of user's environment.
-        bind_textdomain_codeset(d->domain, "UTF-8");
-
-        // Invalidate current language, to trigger binding at next translate call.
-        KCatalogPrivate::currentLanguage.clear();
-
-        if (!s_langenv) {
-            // Call putenv only here, to initialize LANGUAGE variable.
-            // Later only change s_langenv to what is currently needed.
-            // This doesn't work on Windows though, so there we need putenv calls on every change
-            s_langenv = new char[s_langenvMaxlen];
-            copyToLangArr(qgetenv("LANGUAGE"));
-            putenv(s_langenv);
-        }
+        d->loadCatalog();
     }
 }
 
 KCatalog::~KCatalog() = default;
 
-#if defined(Q_OS_ANDROID) && __ANDROID_API__ < 23
-static QString androidUnpackCatalog(const QString &relpath)
-{
-    // the catalog files are no longer extracted to the local file system
-    // by androiddeployqt starting with Qt 5.14, libintl however needs
-    // local files rather than qrc: or asset: URLs, so we unpack the .mo
-    // files on demand to the local cache folder
-
-    const QString cachePath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/org.kde.ki18n/") + relpath;
-    QFileInfo cacheFile(cachePath);
-    if (cacheFile.exists()) {
-        return cachePath;
-    }
-
-    const QString assetPath = QLatin1String("assets:/share/locale/") + relpath;
-    if (!QFileInfo::exists(assetPath)) {
-        return {};
-    }
-
-    QDir().mkpath(cacheFile.absolutePath());
-    QFile f(assetPath);
-    if (!f.copy(cachePath)) {
-        qCWarning(KI18N) << "Failed to copy catalog:" << f.errorString() << assetPath << cachePath;
-        return {};
-    }
-    return cachePath;
-}
-#endif
-
 QString KCatalog::catalogLocaleDir(const QByteArray &domain, const QString &language)
 {
     QString relpath = QStringLiteral("%1/LC_MESSAGES/%2.mo").arg(language, QFile::decodeName(domain));
@@ -190,7 +176,7 @@ QString KCatalog::catalogLocaleDir(const QByteArray &domain, const QString &lang
         const QString filename = customLocaleDir + QLatin1Char('/') + relpath;
         if (!customLocaleDir.isEmpty() && QFileInfo::exists(filename)) {
 #if defined(Q_OS_ANDROID)
-            // The exact file name must be returned on Android because libintl-lite loads a catalog by filename with bindtextdomain()
+            // The exact file name is returned on Android, as catalogs may also be read from assets
             return filename;
 #else
             return customLocaleDir;
@@ -199,13 +185,6 @@ QString KCatalog::catalogLocaleDir(const QByteArray &domain, const QString &lang
     }
 
 #if defined(Q_OS_ANDROID)
-#if __ANDROID_API__ < 23
-    // fall back to copying the catalog to the file system on old systems
-    // without fmemopen()
-    if (!catalogStaticData->fmemopenFunc) {
-        return androidUnpackCatalog(relpath);
-    }
-#endif
     const QString assetPath = QLatin1String("assets:/share/locale/") + relpath;
     if (!QFileInfo::exists(assetPath)) {
         return {};
@@ -272,146 +251,71 @@ QSet<QString> KCatalog::availableCatalogLanguages(const QByteArray &domain_)
     return availableLanguages;
 }
 
-#ifdef Q_OS_ANDROID
-static void androidAssetBindtextdomain(const QByteArray &domain, const QByteArray &localeDir)
+QString KCatalog::translate(const QByteArray &msgid) const
 {
-    AAsset *asset = AAssetManager_open(catalogStaticData->m_assetMgr, localeDir.mid(8).constData(), AASSET_MODE_UNKNOWN);
-    if (!asset) {
-        qWarning() << "unable to load asset" << localeDir;
-        return;
-    }
-
-    off64_t size = AAsset_getLength64(asset);
-    const void *buffer = AAsset_getBuffer(asset);
-#if __ANDROID_API__ >= 23
-    FILE *moFile = fmemopen(const_cast<void *>(buffer), size, "r");
-#else
-    FILE *moFile = catalogStaticData->fmemopenFunc(const_cast<void *>(buffer), size, "r");
-#endif
-    loadMessageCatalogFile(domain, moFile);
-    fclose(moFile);
-    AAsset_close(asset);
+    return translate(KMoKeyHash(QByteArray(), msgid), QByteArray(), msgid);
 }
-#endif
 
-void KCatalogPrivate::setupGettextEnv()
+QString KCatalog::translate(const QByteArray &msgctxt, const QByteArray &msgid) const
 {
-    // Point Gettext to current language, recording system value for recovery.
-    systemLanguage = qgetenv("LANGUAGE");
-    if (systemLanguage != language) {
-        // putenv has been called in the constructor,
-        // it is enough to change the string set there.
-        copyToLangArr(language);
-#ifdef Q_OS_WINDOWS
-        putenv(s_langenv);
-#endif
-    }
-
-    // Rebind text domain if language actually changed from the last time,
-    // as locale directories may differ for different languages of same catalog.
-    if (language != currentLanguage || !bindDone) {
-        Q_ASSERT_X(QCoreApplication::instance(), "KCatalogPrivate::setupGettextEnv", "You need to instantiate a Q*Application before using KCatalog");
-        if (!QCoreApplication::instance()) {
-            qCWarning(KI18N) << "KCatalog being used without a Q*Application instance. Some translations won't work";
-        }
-
-        currentLanguage = language;
-        bindDone = true;
-
-        // qDebug() << "bindtextdomain" << domain << localeDir;
-#ifdef Q_OS_ANDROID
-        if (localeDir.startsWith("assets:/")) {
-            androidAssetBindtextdomain(domain, localeDir);
-        } else {
-            bindtextdomain(domain, localeDir);
-        }
-#else
-        bindtextdomain(domain, localeDir);
-#endif
-
-#if HAVE_NL_MSG_CAT_CNTR
-        // Magic to make sure GNU Gettext doesn't use stale cached translation
-        // from previous language.
-        ++_nl_msg_cat_cntr;
-#endif
-    }
+    return translate(KMoKeyHash(msgctxt, msgid), msgctxt, msgid);
 }
 
-void KCatalogPrivate::resetSystemLanguage()
+QString KCatalog::translate(const QByteArray &msgid, const QByteArray &msgid_plural, qulonglong n) const
 {
-    if (language != systemLanguage) {
-        copyToLangArr(systemLanguage);
-#ifdef Q_OS_WINDOWS
-        putenv(s_langenv);
-#endif
+    Q_UNUSED(msgid_plural);
+    if (!d->mo) {
+        return QString();
     }
+    return d->decode(d->mo->translate(QByteArray(), msgid, KMoKeyHash(QByteArray(), msgid), n));
 }
 
-QString KCatalog::translate(const QByteArray &msgid) const
+QString KCatalog::translate(const QByteArray &msgctxt, const QByteArray &msgid, const QByteArray &msgid_plural, qulonglong n) const
 {
-    if (!d->localeDir.isEmpty()) {
-        QMutexLocker locker(&catalogStaticData()->mutex);
-        d->setupGettextEnv();
-        const char *msgid_char = msgid.constData();
-        const char *msgstr = dgettext(d->domain.constData(), msgid_char);
-        d->resetSystemLanguage();
-        return msgstr != msgid_char // Yes we want pointer comparison
-            ? QString::fromUtf8(msgstr)
-            : QString();
-    } else {
+    Q_UNUSED(msgid_plural);
+    if (!d->mo) {
         return QString();
     }
+    return d->decode(d->mo->translate(msgctxt, msgid, KMoKeyHash(msgctxt, msgid), n));
 }
 
-QString KCatalog::translate(const QByteArray &msgctxt, const QByteArray &msgid) const
+QStringList KCatalog::translatePluralForms(const QByteArray &msgctxt, const QByteArray &msgid) const
 {
-    if (!d->localeDir.isEmpty()) {
-        QMutexLocker locker(&catalogStaticData()->mutex);
-        d->setupGettextEnv();
-        const char *msgid_char = msgid.constData();
-        const char *msgstr = dpgettext_expr(d->domain.constData(), msgctxt.constData(), msgid_char);
-        d->resetSystemLanguage();
-        return msgstr != msgid_char // Yes we want pointer comparison
-            ? QString::fromUtf8(msgstr)
-            : QString();
-    } else {
-        return QString();
-    }
+    return translatePluralForms(KMoKeyHash(msgctxt, msgid), msgctxt, msgid);
 }
 
-QString KCatalog::translate(const QByteArray &msgid, const QByteArray &msgid_plural, qulonglong n) const
+QString KCatalog::translate(const KMoKeyHash &hash, const QByteArray &msgctxt, const QByteArray &msgid) const
 {
-    if (!d->localeDir.isEmpty()) {
-        QMutexLocker locker(&catalogStaticData()->mutex);
-        d->setupGettextEnv();
-        const char *msgid_char = msgid.constData();
-        const char *msgid_plural_char = msgid_plural.constData();
-        const char *msgstr = dngettext(d->domain.constData(), msgid_char, msgid_plural_char, n);
-        d->resetSystemLanguage();
-        // If original and translation are same, dngettext will return
-        // the original pointer, which is generally fine, except in
-        // the corner cases where e.g. msgstr[1] is same as msgid.
-        // Therefore check for pointer difference only with msgid or
-        // only with msgid_plural, and not with both.
-        return (n == 1 && msgstr != msgid_char) || (n != 1 && msgstr != msgid_plural_char) ? QString::fromUtf8(msgstr) : QString();
-    } else {
+    if (!d->mo) {
         return QString();
     }
+    return d->decode(d->mo->translate(msgctxt, msgid, hash));
 }
 
-QString KCatalog::translate(const QByteArray &msgctxt, const QByteArray &msgid, const QByteArray &msgid_plural, qulonglong n) const
+QStringList KCatalog::translatePluralForms(const KMoKeyHash &hash, const QByteArray &msgctxt, const QByteArray &msgid) const
 {
-    if (!d->localeDir.isEmpty()) {
-        QMutexLocker locker(&catalogStaticData()->mutex);
-        d->setupGettextEnv();
-        const char *msgid_char = msgid.constData();
-        const char *msgid_plural_char = msgid_plural.constData();
-        const char *msgstr = dnpgettext_expr(d->domain.constData(), msgctxt.constData(), msgid_char, msgid_plural_char, n);
-        d->resetSystemLanguage();
-        return (n == 1 && msgstr != msgid_char) || (n != 1 && msgstr != msgid_plural_char) ? QString::fromUtf8(msgstr) : QString();
-    } else {
-        return QString();
+    if (!d->mo) {
+        return QStringList();
     }
+    const QByteArrayView forms = d->mo->translatePluralForms(msgctxt, msgid, hash);
+    if (forms.isEmpty()) {
+        return QStringList();
+    }
+    QStringList msgstrs;
+    for (qsizetype start = 0; start <= forms.size();) {
+        qsizetype end = forms.indexOf('\0', start);
+        if (end < 0) {
+            end = forms.size();
+        }
+        msgstrs.append(d->decode(forms.sliced(start, end - start)));
+        start = end + 1;
+    }
+    return msgstrs;
+}
+
+qsizetype KCatalog::pluralForm(qulonglong n) const
+{
+    return d->mo ? qsizetype(d->mo->pluralForm(n)) : (n == 1 ? 0 : 1);
 }
 
 void KCatalog::addDomainLocaleDir(const QByteArray &domain, const QString &path)
@@ -13,13 +13,17 @@
 #include <QByteArray>
 #include <QSet>
 #include <QString>
+#include <QStringList>
 #include <memory>
 
 class KCatalogPrivate;
+class KMoKeyHash;
 
 /*!
  * This class abstracts a Gettext message catalog.
- * It takes care of needed Gettext bindings.
+ * The compiled catalog file is mapped into memory once
+ * and translations are looked up in it directly,
+ * without going through Gettext and its global state.
  *
  * \sa KLocalizedString
  * \internal exported only for use in KI18nLocaleData.
@@ -97,6 +101,58 @@ public:
      */
     QString translate(const QByteArray &msgctxt, const QByteArray &msgid, const QByteArray &msgid_plural, qulonglong n) const;
 
+    /*!
+     * Get all plural forms of the translation of given message.
+     *
+     * Do not pass empty message text.
+     *
+     * \a msgctxt message context, null if the message has no context
+     *
+     * \a msgid singular message text
+     *
+     * Returns translated forms if found, empty list otherwise
+     */
+    QStringList translatePluralForms(const QByteArray &msgctxt, const QByteArray &msgid) const;
+
+    /*!
+     * Get translation of given message, with the key already hashed.
+     *
+     * Hashing the key once and using it for lookups in catalogs of
+     * several languages saves work, and catalogs which do not contain
+     * the message reject it without searching.
+     *
+     * \a hash hash values of \a msgctxt and \a msgid
+     *
+     * \a msgctxt message context, null if the message has no context
+     *
+     * \a msgid message text
+     *
+     * Returns translated message if found, QString() otherwise
+     */
+    QString translate(const KMoKeyHash &hash, const QByteArray &msgctxt, const QByteArray &msgid) const;
+
+    /*!
+     * Get all plural forms of the translation of given message,
+     * with the key already hashed.
+     *
+     * \a hash hash values of \a msgctxt and \a msgid
+     *
+     * \a msgctxt message context, null if the message has no context
+     *
+     * \a msgid singular message text
+     *
+     * Returns translated forms if found, empty list otherwise
+     */
+    QStringList translatePluralForms(const KMoKeyHash &hash, const QByteArray &msgctxt, const QByteArray &msgid) const;
+
+    /*!
+     * Get the index of the plural form to use for the given number,
+     * according to the plural rule of the catalog.
+     *
+     * \a n number for which the plural form is needed
+     */
+    qsizetype pluralForm(qulonglong n) const;
+
     /*!
      * Find the locale directory for the given domain in the given language.
      *
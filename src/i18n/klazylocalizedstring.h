@@ -119,6 +119,29 @@ public:
         return this->operator KLocalizedString().toString();
     }
 
+    /*!
+     * Finalize the translations of several messages at once.
+     *
+     * Meant for message tables, such as those filling a combo box,
+     * which are translated faster this way than by calling toString
+     * on each message. The translation domain active at this point
+     * is used for all messages.
+     *
+     * \a messages the messages to translate
+     *
+     * Returns finalized translations, in the order of \a messages
+     *
+     * \since 6.30
+     */
+    Q_REQUIRED_RESULT static inline QStringList toStringList(QSpan<const KLazyLocalizedString> messages)
+    {
+#ifdef TRANSLATION_DOMAIN
+        return KLocalizedString::toStringList(messages, TRANSLATION_DOMAIN);
+#else
+        return KLocalizedString::toStringList(messages, nullptr);
+#endif
+    }
+
     /*!
      * Like toString(), but look for translation only in given languages.
      *
@@ -169,7 +192,9 @@ public:
      */
     Q_REQUIRED_RESULT inline KLocalizedString withLanguages(const QStringList &languages) const
     {
-        return this->operator KLocalizedString().withLanguages(languages);
+        KLocalizedString message = this->operator KLocalizedString();
+        message.replaceLanguages(languages);
+        return message;
     }
 
     /*!
@@ -181,7 +206,9 @@ public:
      */
     Q_REQUIRED_RESULT inline KLocalizedString withDomain(const char *domain) const
     {
-        return this->operator KLocalizedString().withDomain(domain);
+        KLocalizedString message = this->operator KLocalizedString();
+        message.replaceDomain(domain);
+        return message;
     }
 
     /*!
@@ -195,7 +222,9 @@ public:
      */
     Q_REQUIRED_RESULT inline KLocalizedString withFormat(Kuit::VisualFormat format) const
     {
-        return this->operator KLocalizedString().withFormat(format);
+        KLocalizedString message = this->operator KLocalizedString();
+        message.replaceFormat(format);
+        return message;
     }
 
     /*!
@@ -216,7 +245,9 @@ public:
      */
     Q_REQUIRED_RESULT inline KLocalizedString subs(int a, int fieldWidth = 0, int base = 10, QChar fillChar = QLatin1Char(' ')) const
     {
-        return this->operator KLocalizedString().subs(a, fieldWidth, base, fillChar);
+        KLocalizedString message = this->operator KLocalizedString();
+        message.substitute(a, fieldWidth, base, fillChar);
+        return message;
     }
 
     /*!
@@ -237,7 +268,9 @@ public:
      */
     Q_REQUIRED_RESULT inline KLocalizedString subs(uint a, int fieldWidth = 0, int base = 10, QChar fillChar = QLatin1Char(' ')) const
     {
-        return this->operator KLocalizedString().subs(a, fieldWidth, base, fillChar);
+        KLocalizedString message = this->operator KLocalizedString();
+        message.substitute(a, fieldWidth, base, fillChar);
+        return message;
     }
 
     /*!
@@ -258,7 +291,9 @@ public:
      */
     Q_REQUIRED_RESULT inline KLocalizedString subs(long a, int fieldWidth = 0, int base = 10, QChar fillChar = QLatin1Char(' ')) const
     {
-        return this->operator KLocalizedString().subs(a, fieldWidth, base, fillChar);
+        KLocalizedString message = this->operator KLocalizedString();
+        message.substitute(a, fieldWidth, base, fillChar);
+        return message;
     }
 
     /*!
@@ -279,7 +314,9 @@ public:
      */
     Q_REQUIRED_RESULT inline KLocalizedString subs(ulong a, int fieldWidth = 0, int base = 10, QChar fillChar = QLatin1Char(' ')) const
     {
-        return this->operator KLocalizedString().subs(a, fieldWidth, base, fillChar);
+        KLocalizedString message = this->operator KLocalizedString();
+        message.substitute(a, fieldWidth, base, fillChar);
+        return message;
     }
 
     /*!
@@ -300,7 +337,9 @@ public:
      */
     Q_REQUIRED_RESULT inline KLocalizedString subs(qlonglong a, int fieldWidth = 0, int base = 10, QChar fillChar = QLatin1Char(' ')) const
     {
-        return this->operator KLocalizedString().subs(a, fieldWidth, base, fillChar);
+        KLocalizedString message = this->operator KLocalizedString();
+        message.substitute(a, fieldWidth, base, fillChar);
+        return message;
     }
 
     /*!
@@ -321,7 +360,9 @@ public:
      */
     Q_REQUIRED_RESULT inline KLocalizedString subs(qulonglong a, int fieldWidth = 0, int base = 10, QChar fillChar = QLatin1Char(' ')) const
     {
-        return this->operator KLocalizedString().subs(a, fieldWidth, base, fillChar);
+        KLocalizedString message = this->operator KLocalizedString();
+        message.substitute(a, fieldWidth, base, fillChar);
+        return message;
     }
     /*!
      * Substitute a double argument into the message.
@@ -342,7 +383,9 @@ public:
      */
     Q_REQUIRED_RESULT inline KLocalizedString subs(double a, int fieldWidth = 0, char format = 'g', int precision = -1, QChar fillChar = QLatin1Char(' ')) const
     {
-        return this->operator KLocalizedString().subs(a, fieldWidth, format, precision, fillChar);
+        KLocalizedString message = this->operator KLocalizedString();
+        message.substitute(a, fieldWidth, format, precision, fillChar);
+        return message;
     }
 
     /*!
@@ -360,7 +403,9 @@ public:
      */
     Q_REQUIRED_RESULT inline KLocalizedString subs(QChar a, int fieldWidth = 0, QChar fillChar = QLatin1Char(' ')) const
     {
-        return this->operator KLocalizedString().subs(a, fieldWidth, fillChar);
+        KLocalizedString message = this->operator KLocalizedString();
+        message.substitute(a, fieldWidth, fillChar);
+        return message;
     }
 
     /*!
@@ -378,7 +423,9 @@ public:
      */
     Q_REQUIRED_RESULT inline KLocalizedString subs(const QString &a, int fieldWidth = 0, QChar fillChar = QLatin1Char(' ')) const
     {
-        return this->operator KLocalizedString().subs(a, fieldWidth, fillChar);
+        KLocalizedString message = this->operator KLocalizedString();
+        message.substitute(a, fieldWidth, fillChar);
+        return message;
     }
 
     /*!
@@ -396,7 +443,9 @@ public:
      */
     Q_REQUIRED_RESULT inline KLocalizedString subs(const KLocalizedString &a, int fieldWidth = 0, QChar fillChar = QLatin1Char(' ')) const
     {
-        return this->operator KLocalizedString().subs(a, fieldWidth, fillChar);
+        KLocalizedString message = this->operator KLocalizedString();
+        message.substitute(a, fieldWidth, fillChar);
+        return message;
     }
 
     /*!
@@ -453,6 +502,8 @@ public:
     }
 
 private:
+    friend class KLocalizedString;
+
     template<std::size_t TextSize>
     friend inline constexpr KLazyLocalizedString kli18n(const char (&text)[TextSize]);
     template<std::size_t ContextSize, std::size_t TextSize>
@@ -10,8 +10,12 @@
 #include "config.h"
 
 #include <cstdlib>
+#include <memory>
 
+#include <QAtomicInteger>
+#include <QAtomicPointer>
 #include <QByteArray>
+#include <QCache>
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
@@ -24,10 +28,14 @@
 #include <QRecursiveMutex>
 #include <QStandardPaths>
 #include <QStringList>
+#include <QThread>
+#include <QVarLengthArray>
 
 #include <common_helpers_p.h>
 #include <kcatalog_p.h>
+#include <klazylocalizedstring.h>
 #include <klocalizedstring.h>
+#include <kmofile_p.h>
 #include <ktranscript_p.h>
 #include <kuitsetup_p.h>
 
@@ -160,6 +168,167 @@ typedef qlonglong intn;
 typedef qulonglong uintn;
 typedef double realn;
 
+// Translation with the positions of its placeholders, parsed once
+// so that arguments can be substituted in a single pass.
+class KPlaceholderTemplate
+{
+public:
+    explicit KPlaceholderTemplate(const QString &translation, QChar plchar = QLatin1Char('%'));
+
+    struct Segment {
+        qsizetype position;
+        qsizetype length;
+        // Zero based ordinal of the placeholder following the text,
+        // -1 for the text after the last placeholder.
+        int ordinal;
+    };
+
+    QString translation;
+    QList<Segment> segments;
+    // Length of all text outside of placeholders.
+    qsizetype literalLength = 0;
+    // Indicates which placeholders are present, by ordinal.
+    QList<bool> ordinals;
+};
+
+KPlaceholderTemplate::KPlaceholderTemplate(const QString &translation_, QChar plchar)
+    : translation(translation_)
+{
+    const QStringView text = translation;
+    const auto slen = text.length();
+    qsizetype spos = 0;
+    auto tpos = text.indexOf(plchar);
+    while (tpos >= 0) {
+        auto ctpos = tpos;
+
+        ++tpos;
+        if (tpos == slen) {
+            break;
+        }
+
+        if (text[tpos].digitValue() > 0) {
+            // NOTE: %0 is not considered a placeholder.
+            // Get the placeholder ordinal.
+            int plord = 0;
+            while (tpos < slen && text[tpos].digitValue() >= 0) {
+                plord = 10 * plord + text[tpos].digitValue();
+                ++tpos;
+            }
+            --plord; // ordinals are zero based
+
+            if (plord >= ordinals.size()) {
+                ordinals.resize(plord + 1);
+            }
+            ordinals[plord] = true;
+
+            // Store text segment prior to placeholder and placeholder number.
+            segments.append({spos, ctpos - spos, plord});
+            literalLength += ctpos - spos;
+
+            // Position of next text segment.
+            spos = tpos;
+        }
+
+        tpos = text.indexOf(plchar, tpos);
+    }
+    // Store last text segment.
+    segments.append({spos, slen - spos, -1});
+    literalLength += slen - spos;
+}
+
+// Scripted translation parsed into its text and interpolations, so that
+// for each set of arguments the interpolations need only be evaluated.
+class KTranscriptTemplate
+{
+public:
+    explicit KTranscriptTemplate(const QString &translation);
+
+    // Part of an interpolation argument.
+    struct Segment {
+        enum Type : quint8 {
+            Quoted,
+            Free,
+            Interpolation,
+        };
+
+        Type type;
+        // For free segments looking like a value reference, index of
+        // the value, for sub-interpolations, their index; -1 otherwise.
+        int index;
+        KPlaceholderTemplate text;
+    };
+
+    struct Interpolation {
+        // Arguments, each concatenated from its segments.
+        QList<QList<Segment>> arguments;
+        // The interpolation as written, for warnings.
+        QString source;
+    };
+
+    struct Piece {
+        KPlaceholderTemplate text;
+        // Index of the interpolation following the text, -1 for the last text.
+        int interpolation;
+    };
+
+    QString translation;
+    QList<Piece> pieces;
+    // Sub-interpolations come before the interpolations they are part of.
+    QList<Interpolation> interpolations;
+    // False if the translation could not be parsed.
+    bool isValid = true;
+
+private:
+    qsizetype parseInterpolation(qsizetype pos, int &index);
+};
+
+// Argument substituted into a message. Its value, as seen by
+// scripted translations, is made into a QVariant only when needed.
+class KLocalizedStringArgument
+{
+public:
+    enum Type : quint8 {
+        Signed,
+        Unsigned,
+        Real,
+        String,
+        Message,
+    };
+
+    // Formatted argument, empty for messages until resolved in toString.
+    QString text;
+    // Unformatted string argument, if different from the formatted.
+    QString string;
+    std::shared_ptr<const KLocalizedString> message;
+    union {
+        intn signedNumber = 0;
+        uintn unsignedNumber;
+        realn realNumber;
+    };
+    int fieldWidth = 0;
+    QChar fillChar;
+    Type type = String;
+
+    QVariant value() const;
+};
+
+QVariant KLocalizedStringArgument::value() const
+{
+    switch (type) {
+    case Signed:
+        return signedNumber;
+    case Unsigned:
+        return unsignedNumber;
+    case Real:
+        return realNumber;
+    case String:
+        return string.isNull() ? text : string;
+    case Message:
+        break;
+    }
+    return 0;
+}
+
 class KLocalizedStringPrivate
 {
     friend class KLocalizedString;
@@ -170,11 +339,8 @@ class KLocalizedStringPrivate
     QByteArray context;
     QByteArray text;
     QByteArray plural;
-    QStringList arguments;
-    QList<QVariant> values;
-    QHash<int, KLocalizedString> klsArguments;
-    QHash<int, int> klsArgumentFieldWidths;
-    QHash<int, QChar> klsArgumentFillChars;
+    // Most messages have only a few arguments, keep those inline.
+    QVarLengthArray<KLocalizedStringArgument, 4> arguments;
     bool numberSet = false;
     pluraln number;
     qsizetype numberOrdinal;
@@ -191,10 +357,12 @@ class KLocalizedStringPrivate
                              const QByteArray &msgid_plural,
                              qulonglong n,
                              QString &language,
-                             QString &msgstr);
+                             QString &msgstr,
+                             std::shared_ptr<const KPlaceholderTemplate> &msgTemplate);
 
     QString toString(const QByteArray &domain, const QStringList &languages, Kuit::VisualFormat format, bool isArgument = false) const;
     QString substituteSimple(const QString &translation, const QStringList &arguments, QChar plchar = QLatin1Char('%'), bool isPartial = false) const;
+    QString substituteSimple(const KPlaceholderTemplate &translation, const QStringList &arguments, bool isPartial = false) const;
     QString formatMarkup(const QByteArray &domain, const QString &language, const QString &context, const QString &text, Kuit::VisualFormat format) const;
     QString substituteTranscript(const QString &scriptedTranslation,
                                  const QString &language,
@@ -203,16 +371,17 @@ class KLocalizedStringPrivate
                                  const QStringList &arguments,
                                  const QList<QVariant> &values,
                                  bool &fallback) const;
-    qsizetype resolveInterpolation(const QString &scriptedTranslation,
-                                   qsizetype pos,
-                                   const QString &language,
-                                   const QString &country,
-                                   const QString &ordinaryTranslation,
-                                   const QStringList &arguments,
-                                   const QList<QVariant> &values,
-                                   QString &result,
-                                   bool &fallback) const;
-    QVariant segmentToValue(const QString &segment) const;
+    QString resolveInterpolation(const KTranscriptTemplate &translationTemplate,
+                                 int index,
+                                 const QString &language,
+                                 const QString &country,
+                                 const QString &msgctxt,
+                                 const QString &msgid,
+                                 const QString &ordinaryTranslation,
+                                 const QStringList &arguments,
+                                 const QList<QVariant> &values,
+                                 bool &fallback) const;
+    QVariant segmentToValue(const KTranscriptTemplate::Segment &segment) const;
     QString postTranscript(const QString &pcall,
                            const QString &language,
                            const QString &country,
@@ -249,6 +418,9 @@ class KLocalizedStringPrivateStatics
 {
 public:
     QHash<QByteArray, KCatalogPtrHash> catalogs;
+    // Catalogs replaced after their domain got a new locale directory,
+    // threads may still use them until they next copy the settings.
+    QList<KCatalog *> retiredCatalogs;
     QStringList languages;
 
     QByteArray ourDomain = QByteArrayLiteral("ki18n6");
@@ -265,18 +437,23 @@ public:
 
     static constexpr inline auto scriptDir = "LC_SCRIPTS"_L1;
     QHash<QString, QList<QByteArray>> scriptModules;
+    // Modules located so far, in order, for the interpreters
+    // of each thread to load when they next evaluate.
     QList<QStringList> scriptModulesToLoad;
 
     bool loadTranscriptCalled = false;
-    KTranscript *ktrs = nullptr;
-
-    QHash<QString, KuitFormatter *> formatters;
+    QAtomicPointer<KTranscript> ktrs;
 
     QList<QByteArray> qtDomains;
     QList<int> qtDomainInsertCount;
 
     QRecursiveMutex klspMutex;
 
+    // Incremented whenever applicationDomain, languages or catalog
+    // locations change, so that threads know when their own copies
+    // and cached translations have gone stale.
+    QAtomicInt settingsGeneration;
+
     KLocalizedStringPrivateStatics();
     ~KLocalizedStringPrivateStatics();
 
@@ -296,22 +473,137 @@ KLocalizedStringPrivateStatics::~KLocalizedStringPrivateStatics()
     for (const KCatalogPtrHash &languageCatalogs : std::as_const(catalogs)) {
         qDeleteAll(languageCatalogs);
     }
+    qDeleteAll(retiredCatalogs);
     // ktrs is handled by QLibrary.
     // delete ktrs;
-    qDeleteAll(formatters);
 }
 
 Q_GLOBAL_STATIC(KLocalizedStringPrivateStatics, staticsKLSP)
 
+// Key of a raw translation, as looked up by KLocalizedStringPrivate::translateRaw.
+// The number for plural messages is not part of the key, the cached entry
+// holds all plural forms instead.
+class KTranslationCacheKey
+{
+public:
+    QByteArray domain;
+    QStringList languages;
+    QByteArray msgctxt;
+    QByteArray msgid;
+    QByteArray msgid_plural;
+    // Hash of context and text, which is computed for catalog lookups anyway.
+    quint64 keyHash;
+
+    bool operator==(const KTranslationCacheKey &other) const
+    {
+        return msgid == other.msgid && msgctxt.isNull() == other.msgctxt.isNull() && msgctxt == other.msgctxt
+            && msgid_plural.isNull() == other.msgid_plural.isNull() && msgid_plural == other.msgid_plural && domain == other.domain
+            && languages == other.languages;
+    }
+};
+
+static size_t qHash(const KTranslationCacheKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.keyHash, key.domain, key.languages, key.msgid_plural);
+}
+
+class KTranslationCacheEntry
+{
+public:
+    QString language;
+    // Catalog in which the translation was found, null if the message
+    // is not translated and msgstrs hold the original texts.
+    const KCatalog *catalog = nullptr;
+    // Translation, or all its forms for plural messages.
+    QStringList msgstrs;
+    // Parsed ordinary translations, filled as the forms get used.
+    mutable QList<std::shared_ptr<const KPlaceholderTemplate>> templates;
+
+    const std::shared_ptr<const KPlaceholderTemplate> &msgTemplate(qsizetype form) const;
+};
+
+// Only the ordinary translation has its placeholders substituted directly,
+// the scripted translation after the fence is left to Transcript.
+static std::shared_ptr<const KPlaceholderTemplate> ordinaryTemplate(const QString &msgstr)
+{
+    const auto fencePos = msgstr.indexOf(staticsKLSP()->theFence);
+    return std::make_shared<const KPlaceholderTemplate>(fencePos > 0 ? msgstr.left(fencePos) : msgstr);
+}
+
+const std::shared_ptr<const KPlaceholderTemplate> &KTranslationCacheEntry::msgTemplate(qsizetype form) const
+{
+    if (templates.size() < msgstrs.size()) {
+        templates.resize(msgstrs.size());
+    }
+    if (!templates.at(form)) {
+        templates[form] = ordinaryTemplate(msgstrs.at(form));
+    }
+    return templates.at(form);
+}
+
+// Per-thread copies of the global settings, pointers to the catalogs
+// the thread has already used, and recently used translations.
+// Translating then needs no lock: settings are copied again only after
+// they change, and catalogs are never destroyed before the statics,
+// so only a catalog not seen before by the thread requires synchronization.
+class KLocalizedStringThreadData
+{
+public:
+    int settingsGeneration = -1;
+    QByteArray applicationDomain;
+    QStringList languages;
+    // Set by KLocalizedScope, empty when not overridden.
+    QByteArray scopeDomain;
+    QStringList scopeLanguages;
+    QHash<QByteArray, KCatalogPtrHash> catalogs;
+    QCache<KTranslationCacheKey, KTranslationCacheEntry> translations{4096};
+
+    const QByteArray &domain() const
+    {
+        return scopeDomain.isEmpty() ? applicationDomain : scopeDomain;
+    }
+
+    const QStringList &translationLanguages() const
+    {
+        return scopeLanguages.isEmpty() ? languages : scopeLanguages;
+    }
+};
+
+class KLocalizedScopePrivate
+{
+public:
+    QByteArray previousDomain;
+    QStringList previousLanguages;
+};
+
+static KLocalizedStringThreadData &threadData()
+{
+    thread_local KLocalizedStringThreadData data;
+
+    KLocalizedStringPrivateStatics *s = staticsKLSP();
+    if (data.settingsGeneration != s->settingsGeneration.loadAcquire()) {
+        QMutexLocker lock(&s->klspMutex);
+        data.applicationDomain = s->applicationDomain;
+        data.languages = s->languages;
+        data.catalogs.clear();
+        data.translations.clear();
+        data.settingsGeneration = s->settingsGeneration.loadRelaxed();
+    }
+    return data;
+}
+
 bool LanguageChangeEventHandler::eventFilter(QObject *obj, QEvent *ev)
 {
     if (ev->type() == QEvent::LanguageChange && obj == QCoreApplication::instance()) {
-        const auto langOverride = staticsKLSP->languages != staticsKLSP->localeLanguages;
-        staticsKLSP->localeLanguages.clear();
-        staticsKLSP->initializeLocaleLanguages();
-        qCDebug(KI18N) << "languages changes from" << staticsKLSP->languages << "to" << staticsKLSP->localeLanguages;
+        KLocalizedStringPrivateStatics *s = staticsKLSP();
+        QMutexLocker lock(&s->klspMutex);
+        const auto langOverride = s->languages != s->localeLanguages;
+        s->localeLanguages.clear();
+        s->initializeLocaleLanguages();
+        qCDebug(KI18N) << "languages changes from" << s->languages << "to" << s->localeLanguages;
         if (!langOverride) {
-            staticsKLSP->languages = staticsKLSP->localeLanguages;
+            s->languages = s->localeLanguages;
+            s->settingsGeneration.ref();
         }
     }
     return QObject::eventFilter(obj, ev);
@@ -394,11 +686,27 @@ KLocalizedString::KLocalizedString(const KLocalizedString &rhs)
 KLocalizedString &KLocalizedString::operator=(const KLocalizedString &rhs)
 {
     if (&rhs != this) {
-        *d = *rhs.d;
+        if (d) {
+            *d = *rhs.d;
+        } else {
+            // Assigning to a moved-from message.
+            d = new KLocalizedStringPrivate(*rhs.d);
+        }
     }
     return *this;
 }
 
+KLocalizedString::KLocalizedString(KLocalizedString &&rhs) noexcept
+    : d(std::exchange(rhs.d, nullptr))
+{
+}
+
+KLocalizedString &KLocalizedString::operator=(KLocalizedString &&rhs) noexcept
+{
+    std::swap(d, rhs.d);
+    return *this;
+}
+
 KLocalizedString::~KLocalizedString()
 {
     delete d;
@@ -416,7 +724,8 @@ void KLocalizedStringPrivate::translateRaw(const QByteArray &domain,
                                            const QByteArray &msgid_plural,
                                            qulonglong n,
                                            QString &language,
-                                           QString &msgstr)
+                                           QString &msgstr,
+                                           std::shared_ptr<const KPlaceholderTemplate> &msgTemplate)
 {
     KLocalizedStringPrivateStatics *s = staticsKLSP();
 
@@ -440,40 +749,91 @@ void KLocalizedStringPrivate::translateRaw(const QByteArray &domain,
                             "Using \"\" as plural text, fix the code.";
     }
 
-    // Set translation to text in code language, in case no translation found.
-    msgstr = msgid_plural.isNull() || n == 1 ? QString::fromUtf8(msgid) : QString::fromUtf8(msgid_plural);
-    language = s->codeLanguage;
-
     if (domain.isEmpty()) {
         qCWarning(KI18N) << "KLocalizedString: Domain is not set for this string, translation will not work. Please see https://api.kde.org/frameworks/ki18n/html/prg_guide.html msgid:" << msgid << "msgid_plural:" << msgid_plural
                          << "msgctxt:" << msgctxt;
+        msgstr = msgid_plural.isNull() || n == 1 ? QString::fromUtf8(msgid) : QString::fromUtf8(msgid_plural);
+        language = s->codeLanguage;
         return;
     }
 
+    // Recently used translations are kept with the thread,
+    // with all plural forms so that any number can be served.
+    KLocalizedStringThreadData &data = threadData();
+    // The key is hashed once for the cache and the catalogs of all languages.
+    const KMoKeyHash hash(msgctxt, msgid);
+    KTranslationCacheKey key{domain, languages, msgctxt, msgid, msgid_plural, hash.filter};
+    if (const KTranslationCacheEntry *entry = data.translations.object(key)) {
+        qsizetype form = 0;
+        if (!msgid_plural.isNull()) {
+            form = entry->catalog ? entry->catalog->pluralForm(n) : (n == 1 ? 0 : 1);
+        }
+        // A missing or empty form means that the message must be
+        // looked up in further catalogs, so resolve it anew.
+        if (form < entry->msgstrs.size() && !entry->msgstrs.at(form).isEmpty()) {
+            language = entry->language;
+            msgstr = entry->msgstrs.at(form);
+            msgTemplate = entry->msgTemplate(form);
+            return;
+        }
+    }
+
+    auto entry = std::make_unique<KTranslationCacheEntry>();
+    // The entry can be reused for other numbers only if no catalog
+    // before the one with the translation had some of its forms.
+    bool cacheable = true;
+
     // Languages are ordered from highest to lowest priority.
     for (const QString &testLanguage : languages) {
         // If code language reached, no catalog lookup is needed.
         if (testLanguage == s->codeLanguage) {
-            return;
+            break;
         }
         const KCatalog &catalog = getCatalog(domain, testLanguage);
         QString testMsgstr;
-        if (!msgctxt.isNull() && !msgid_plural.isNull()) {
-            testMsgstr = catalog.translate(msgctxt, msgid, msgid_plural, n);
-        } else if (!msgid_plural.isNull()) {
-            testMsgstr = catalog.translate(msgid, msgid_plural, n);
-        } else if (!msgctxt.isNull()) {
-            testMsgstr = catalog.translate(msgctxt, msgid);
+        qsizetype form = 0;
+        if (!msgid_plural.isNull()) {
+            const QStringList forms = catalog.translatePluralForms(hash, msgctxt, msgid);
+            form = catalog.pluralForm(n);
+            if (form < forms.size()) {
+                testMsgstr = forms.at(form);
+            }
+            if (testMsgstr.isEmpty()) {
+                cacheable = cacheable && forms.isEmpty();
+            } else {
+                entry->msgstrs = forms;
+            }
         } else {
-            testMsgstr = catalog.translate(msgid);
+            testMsgstr = catalog.translate(hash, msgctxt, msgid);
+            entry->msgstrs = QStringList{testMsgstr};
         }
         if (!testMsgstr.isEmpty()) {
             // Translation found.
             language = testLanguage;
             msgstr = testMsgstr;
+            msgTemplate = entry->msgTemplate(form);
+            if (cacheable) {
+                entry->language = language;
+                entry->catalog = &catalog;
+                data.translations.insert(std::move(key), entry.release());
+            }
             return;
         }
     }
+
+    // Set translation to text in code language, as no translation found.
+    language = s->codeLanguage;
+    entry->language = language;
+    entry->msgstrs = QStringList{QString::fromUtf8(msgid)};
+    if (!msgid_plural.isNull()) {
+        entry->msgstrs.append(QString::fromUtf8(msgid_plural));
+    }
+    const qsizetype form = msgid_plural.isNull() || n == 1 ? 0 : 1;
+    msgstr = entry->msgstrs.at(form);
+    msgTemplate = entry->msgTemplate(form);
+    if (cacheable) {
+        data.translations.insert(std::move(key), entry.release());
+    }
 }
 
 QString KLocalizedString::toString() const
@@ -496,12 +856,50 @@ QString KLocalizedString::toString(Kuit::VisualFormat format) const
     return d->toString(d->domain, d->languages, format);
 }
 
+QStringList KLocalizedString::toStringList(QSpan<const KLocalizedString> messages)
+{
+    const KLocalizedStringThreadData &settings = threadData();
+    const QByteArray applicationDomain = settings.domain();
+    const QStringList languages = settings.translationLanguages();
+
+    QStringList translations;
+    translations.reserve(messages.size());
+    for (const KLocalizedString &message : messages) {
+        const KLocalizedStringPrivate *d = message.d;
+        const QByteArray &resolvedDomain = d->domain.isEmpty() ? applicationDomain : d->domain;
+        translations.append(d->toString(resolvedDomain, d->languages.isEmpty() ? languages : d->languages, d->format));
+    }
+    return translations;
+}
+
+QStringList KLocalizedString::toStringList(QSpan<const KLazyLocalizedString> messages, const char *domain)
+{
+    const KLocalizedStringThreadData &settings = threadData();
+    const QByteArray resolvedDomain = domain ? QByteArray(domain) : settings.domain();
+    const QStringList languages = settings.translationLanguages();
+
+    // Lazy messages have no arguments or other state of their own,
+    // so a single private object serves for all of them.
+    KLocalizedStringPrivate message;
+    message.format = Kuit::UndefinedFormat;
+    message.number = 0;
+    message.numberOrdinal = 0;
+    QStringList translations;
+    translations.reserve(messages.size());
+    for (const KLazyLocalizedString &lazy : messages) {
+        message.context = lazy.m_context;
+        message.text = lazy.m_text;
+        message.plural = lazy.m_plural;
+        message.markupAware = lazy.m_markupAware;
+        translations.append(message.toString(resolvedDomain, languages, message.format));
+    }
+    return translations;
+}
+
 QString KLocalizedStringPrivate::toString(const QByteArray &domain, const QStringList &languages, Kuit::VisualFormat format, bool isArgument) const
 {
     KLocalizedStringPrivateStatics *s = staticsKLSP();
 
-    QMutexLocker lock(&s->klspMutex);
-
     // Assure the message has been supplied.
     if (text.isEmpty()) {
         qCWarning(KI18N) << "Trying to convert empty KLocalizedString to QString.";
@@ -518,20 +916,22 @@ QString KLocalizedStringPrivate::toString(const QByteArray &domain, const QStrin
     }
 
     // Resolve inputs.
+    const KLocalizedStringThreadData &settings = threadData();
     QByteArray resolvedDomain = domain;
     if (resolvedDomain.isEmpty()) {
-        resolvedDomain = s->applicationDomain;
+        resolvedDomain = settings.domain();
     }
     QStringList resolvedLanguages = languages;
     if (resolvedLanguages.isEmpty()) {
-        resolvedLanguages = s->languages;
+        resolvedLanguages = settings.translationLanguages();
     }
     Kuit::VisualFormat resolvedFormat = format;
 
     // Get raw translation.
     QString language;
     QString rawTranslation;
-    translateRaw(resolvedDomain, resolvedLanguages, context, text, plural, number, language, rawTranslation);
+    std::shared_ptr<const KPlaceholderTemplate> translationTemplate;
+    translateRaw(resolvedDomain, resolvedLanguages, context, text, plural, number, language, rawTranslation, translationTemplate);
     std::optional<QString> country; // initialized when needed
 
     // Set ordinary translation and possibly scripted translation.
@@ -548,14 +948,17 @@ QString KLocalizedStringPrivate::toString(const QByteArray &domain, const QStrin
 
         // Try to initialize Transcript if not initialized and script not empty.
         // FIXME: And also if Transcript not disabled: where to configure this?
-        if (!s->loadTranscriptCalled && !scriptedTranslation.isEmpty()) {
-            loadTranscript();
-
-            // Definitions from this library's scripting module
-            // must be available to all other modules.
-            // So force creation of this library's catalog here,
-            // to make sure the scripting module is loaded.
-            getCatalog(s->ourDomain, language);
+        if (!scriptedTranslation.isEmpty()) {
+            QMutexLocker lock(&s->klspMutex);
+            if (!s->loadTranscriptCalled) {
+                loadTranscript();
+
+                // Definitions from this library's scripting module
+                // must be available to all other modules.
+                // So force creation of this library's catalog here,
+                // to make sure the scripting module is loaded.
+                getCatalog(s->ourDomain, language);
+            }
         }
     } else if (fencePos < 0) {
         // No script fence, use translation as is.
@@ -565,38 +968,48 @@ QString KLocalizedStringPrivate::toString(const QByteArray &domain, const QStrin
         // This is not allowed, consider message not translated.
         qCWarning(KI18N) << "Scripted message" << shortenMessage(translation) << "without ordinary translation, discarded.";
         translation = plural.isEmpty() || number == 1 ? QString::fromUtf8(text) : QString::fromUtf8(plural);
+        translationTemplate.reset();
+    }
+    if (!translationTemplate) {
+        translationTemplate = std::make_shared<const KPlaceholderTemplate>(translation);
     }
 
     // Resolve substituted KLocalizedString arguments.
     QStringList resolvedArguments;
-    QList<QVariant> resolvedValues;
-    for (int i = 0; i < arguments.size(); i++) {
-        auto lsIt = klsArguments.constFind(i);
-        if (lsIt != klsArguments.constEnd()) {
-            const KLocalizedString &kls = *lsIt;
-            int fieldWidth = klsArgumentFieldWidths.value(i);
-            QChar fillChar = klsArgumentFillChars.value(i);
+    resolvedArguments.reserve(arguments.size());
+    QVarLengthArray<QString, 4> resolvedMessages(arguments.size());
+    for (qsizetype i = 0; i < arguments.size(); i++) {
+        const KLocalizedStringArgument &argument = arguments.at(i);
+        if (argument.type == KLocalizedStringArgument::Message) {
+            const KLocalizedString &kls = *argument.message;
             // Override argument's languages and format, but not domain.
             bool isArgumentSub = true;
             QString resdArg = kls.d->toString(kls.d->domain, resolvedLanguages, resolvedFormat, isArgumentSub);
-            resolvedValues.append(resdArg);
+            resolvedMessages[i] = resdArg;
             if (markupAware && !kls.d->markupAware) {
                 resdArg = Kuit::escape(resdArg);
             }
-            resdArg = QStringLiteral("%1").arg(resdArg, fieldWidth, fillChar);
-            resolvedArguments.append(resdArg);
-        } else {
-            QString resdArg = arguments[i];
-            if (markupAware) {
-                resdArg = Kuit::escape(resdArg);
+            if (argument.fieldWidth != 0) {
+                resdArg = QStringLiteral("%1").arg(resdArg, argument.fieldWidth, argument.fillChar);
             }
             resolvedArguments.append(resdArg);
-            resolvedValues.append(values[i]);
+        } else {
+            resolvedArguments.append(markupAware ? Kuit::escape(argument.text) : argument.text);
         }
     }
+    // Argument values are needed only by scripted translations and post calls.
+    const auto resolveValues = [&]() {
+        QList<QVariant> resolvedValues;
+        resolvedValues.reserve(arguments.size());
+        for (qsizetype i = 0; i < arguments.size(); i++) {
+            const KLocalizedStringArgument &argument = arguments.at(i);
+            resolvedValues.append(argument.type == KLocalizedStringArgument::Message ? QVariant(resolvedMessages.at(i)) : argument.value());
+        }
+        return resolvedValues;
+    };
 
     // Substitute placeholders in ordinary translation.
-    QString finalTranslation = substituteSimple(translation, resolvedArguments);
+    QString finalTranslation = substituteSimple(*translationTemplate, resolvedArguments);
     if (markupAware && !isArgument) {
         // Resolve markup in ordinary translation.
         finalTranslation = formatMarkup(resolvedDomain, language, QString::fromUtf8(context), finalTranslation, resolvedFormat);
@@ -605,9 +1018,10 @@ QString KLocalizedStringPrivate::toString(const QByteArray &domain, const QStrin
     // If there is also a scripted translation.
     if (!scriptedTranslation.isEmpty()) {
         // Evaluate scripted translation.
+        // Transcript evaluates with the interpreters of the calling thread.
         bool fallback = false;
         country = extractCountry(resolvedLanguages);
-        scriptedTranslation = substituteTranscript(scriptedTranslation, language, *country, finalTranslation, resolvedArguments, resolvedValues, fallback);
+        scriptedTranslation = substituteTranscript(scriptedTranslation, language, *country, finalTranslation, resolvedArguments, resolveValues(), fallback);
 
         // If any translation produced and no fallback requested.
         if (!scriptedTranslation.isEmpty() && !fallback) {
@@ -621,98 +1035,59 @@ QString KLocalizedStringPrivate::toString(const QByteArray &domain, const QStrin
 
     // Execute any scripted post calls; they cannot modify the final result,
     // but are used to set states.
-    if (s->ktrs != nullptr) {
+    if (KTranscript *ktrs = s->ktrs.loadAcquire()) {
         if (!country.has_value()) {
             country = extractCountry(resolvedLanguages);
         }
-        const QStringList pcalls = s->ktrs->postCalls(language);
-        for (const QString &pcall : pcalls) {
-            postTranscript(pcall, language, *country, finalTranslation, resolvedArguments, resolvedValues);
+        const QStringList pcalls = ktrs->postCalls(language);
+        if (!pcalls.isEmpty()) {
+            const QList<QVariant> resolvedValues = resolveValues();
+            for (const QString &pcall : pcalls) {
+                postTranscript(pcall, language, *country, finalTranslation, resolvedArguments, resolvedValues);
+            }
         }
     }
 
     return finalTranslation;
 }
 
-QString KLocalizedStringPrivate::substituteSimple(const QString &translationString, const QStringList &arguments, QChar plchar, bool isPartial) const
+QString KLocalizedStringPrivate::substituteSimple(const QString &translation, const QStringList &arguments, QChar plchar, bool isPartial) const
+{
+    return substituteSimple(KPlaceholderTemplate(translation, plchar), arguments, isPartial);
+}
+
+QString KLocalizedStringPrivate::substituteSimple(const KPlaceholderTemplate &translationTemplate, const QStringList &arguments, bool isPartial) const
 {
 #ifdef NDEBUG
     Q_UNUSED(isPartial);
 #endif
 
-    QStringView translation = translationString;
-    QVarLengthArray<QStringView, 8> tsegs; // text segments per placeholder occurrence
-    QVarLengthArray<int, 8> plords; // ordinal numbers per placeholder occurrence
-#ifndef NDEBUG
-    QList<int> ords; // indicates which placeholders are present
-#endif
-    auto slen = translation.length();
-    qsizetype spos = 0;
-    auto tpos = translation.indexOf(plchar);
-    while (tpos >= 0) {
-        auto ctpos = tpos;
+    const QStringView translation = translationTemplate.translation;
 
-        ++tpos;
-        if (tpos == slen) {
-            break;
+    // Compute the exact length first, so that the string is allocated once.
+    qsizetype length = translationTemplate.literalLength;
+    for (const KPlaceholderTemplate::Segment &segment : translationTemplate.segments) {
+        if (segment.ordinal < 0) {
+            continue;
         }
-
-        if (translation[tpos].digitValue() > 0) {
-            // NOTE: %0 is not considered a placeholder.
-            // Get the placeholder ordinal.
-            int plord = 0;
-            while (tpos < slen && translation[tpos].digitValue() >= 0) {
-                plord = 10 * plord + translation[tpos].digitValue();
-                ++tpos;
-            }
-            --plord; // ordinals are zero based
-
-#ifndef NDEBUG
-            // Perhaps enlarge storage for indicators.
-            // Note that QList<int> will initialize new elements to 0,
-            // as they are supposed to be.
-            if (plord >= ords.size()) {
-                ords.resize(plord + 1);
-            }
-
-            // Indicate that placeholder with computed ordinal is present.
-            ords[plord] = 1;
-#endif
-
-            // Store text segment prior to placeholder and placeholder number.
-            tsegs.append(translation.mid(spos, ctpos - spos));
-            plords.append(plord);
-
-            // Position of next text segment.
-            spos = tpos;
+        if (segment.ordinal < arguments.size()) {
+            length += arguments.at(segment.ordinal).size();
+        } else {
+            length += 1 + QString::number(segment.ordinal + 1).size();
         }
-
-        tpos = translation.indexOf(plchar, tpos);
-    }
-    // Store last text segment.
-    tsegs.append(translation.mid(spos));
-
-#ifndef NDEBUG
-    // Perhaps enlarge storage for plural-number ordinal.
-    if (!plural.isEmpty() && numberOrdinal >= ords.size()) {
-        ords.resize(numberOrdinal + 1);
-    }
-
-    // Message might have plural but without plural placeholder, which is an
-    // allowed state. To ease further logic, indicate that plural placeholder
-    // is present anyway if message has plural.
-    if (!plural.isEmpty()) {
-        ords[numberOrdinal] = 1;
     }
-#endif
 
     // Assemble the final string from text segments and arguments.
     QString finalTranslation;
-    for (int i = 0; i < plords.size(); i++) {
-        finalTranslation.append(tsegs.at(i));
-        if (plords.at(i) >= arguments.size()) { // too little arguments
+    finalTranslation.reserve(length);
+    for (const KPlaceholderTemplate::Segment &segment : translationTemplate.segments) {
+        finalTranslation.append(translation.mid(segment.position, segment.length));
+        if (segment.ordinal < 0) {
+            break;
+        }
+        if (segment.ordinal >= arguments.size()) { // too little arguments
             // put back the placeholder
-            finalTranslation.append(QLatin1Char('%') + QString::number(plords.at(i) + 1));
+            finalTranslation.append(QLatin1Char('%') + QString::number(segment.ordinal + 1));
 #ifndef NDEBUG
             if (!isPartial) {
                 // spoof the message
@@ -720,13 +1095,27 @@ QString KLocalizedStringPrivate::substituteSimple(const QString &translationStri
             }
 #endif
         } else { // just fine
-            finalTranslation.append(arguments.at(plords.at(i)));
+            finalTranslation.append(arguments.at(segment.ordinal));
         }
     }
-    finalTranslation.append(tsegs.last());
 
 #ifndef NDEBUG
     if (!isPartial && !relaxedSubs) {
+        // Indicators of which placeholders are present.
+        QList<bool> ords = translationTemplate.ordinals;
+
+        // Perhaps enlarge storage for plural-number ordinal.
+        if (!plural.isEmpty() && numberOrdinal >= ords.size()) {
+            ords.resize(numberOrdinal + 1);
+        }
+
+        // Message might have plural but without plural placeholder, which is an
+        // allowed state. To ease further logic, indicate that plural placeholder
+        // is present anyway if message has plural.
+        if (!plural.isEmpty()) {
+            ords[numberOrdinal] = true;
+        }
+
         // Check that there are no gaps in numbering sequence of placeholders.
         bool gaps = false;
         for (int i = 0; i < ords.size(); i++) {
@@ -760,200 +1149,184 @@ QString KLocalizedStringPrivate::substituteSimple(const QString &translationStri
     return finalTranslation;
 }
 
+class KuitThreadFormatters
+{
+public:
+    ~KuitThreadFormatters()
+    {
+        qDeleteAll(byLanguage);
+    }
+
+    QHash<QString, KuitFormatter *> byLanguage;
+    // Tag patterns are translated, so formatters are made anew
+    // when languages or catalogs may have changed.
+    int settingsGeneration = -1;
+};
+
 QString KLocalizedStringPrivate::formatMarkup(const QByteArray &domain,
                                               const QString &language,
                                               const QString &context,
                                               const QString &text,
                                               Kuit::VisualFormat format) const
 {
-    KLocalizedStringPrivateStatics *s = staticsKLSP();
+    // KUIT setups can be used without locking, while formatters
+    // keep caches of formatted texts, so each thread has its own.
+    thread_local KuitThreadFormatters formatters;
 
-    QHash<QString, KuitFormatter *>::iterator formatter = s->formatters.find(language);
-    if (formatter == s->formatters.end()) {
-        formatter = s->formatters.insert(language, new KuitFormatter(language));
+    const int settingsGeneration = staticsKLSP()->settingsGeneration.loadAcquire();
+    if (formatters.settingsGeneration != settingsGeneration) {
+        qDeleteAll(formatters.byLanguage);
+        formatters.byLanguage.clear();
+        formatters.settingsGeneration = settingsGeneration;
+    }
+
+    QHash<QString, KuitFormatter *>::iterator formatter = formatters.byLanguage.find(language);
+    if (formatter == formatters.byLanguage.end()) {
+        formatter = formatters.byLanguage.insert(language, new KuitFormatter(language));
     }
     return (*formatter)->format(domain, context, text, format);
 }
 
-QString KLocalizedStringPrivate::substituteTranscript(const QString &scriptedTranslation,
-                                                      const QString &language,
-                                                      const QString &country,
-                                                      const QString &ordinaryTranslation,
-                                                      const QStringList &arguments,
-                                                      const QList<QVariant> &values,
-                                                      bool &fallback) const
+KTranscriptTemplate::KTranscriptTemplate(const QString &translation_)
+    : translation(translation_)
 {
-    KLocalizedStringPrivateStatics *s = staticsKLSP();
-
-    if (s->ktrs == nullptr) {
-        // Scripting engine not available.
-        return QString();
-    }
+    using Statics = KLocalizedStringPrivateStatics;
 
     // Iterate by interpolations.
-    QString finalTranslation;
-    fallback = false;
     qsizetype ppos = 0;
-    auto tpos = scriptedTranslation.indexOf(s->startInterp);
+    auto tpos = translation.indexOf(Statics::startInterp);
     while (tpos >= 0) {
-        // Resolve substitutions in preceding text.
-        QString ptext = substituteSimple(scriptedTranslation.mid(ppos, tpos - ppos), arguments, s->scriptPlchar, true);
-        finalTranslation.append(ptext);
-
-        // Resolve interpolation.
-        QString result;
-        bool fallbackLocal;
-        tpos = resolveInterpolation(scriptedTranslation, tpos, language, country, ordinaryTranslation, arguments, values, result, fallbackLocal);
+        const QString ptext = translation.mid(ppos, tpos - ppos);
 
         // If there was a problem in parsing the interpolation, cannot proceed
         // (debug info already reported while parsing).
+        int index;
+        tpos = parseInterpolation(tpos, index);
         if (tpos < 0) {
-            return QString();
-        }
-        // If fallback has been explicitly requested, indicate global fallback
-        // but proceed with evaluations (other interpolations may set states).
-        if (fallbackLocal) {
-            fallback = true;
+            isValid = false;
+            return;
         }
-
-        // Add evaluated interpolation to the text.
-        finalTranslation.append(result);
+        pieces.append({KPlaceholderTemplate(ptext, Statics::scriptPlchar), index});
 
         // On to next interpolation.
         ppos = tpos;
-        tpos = scriptedTranslation.indexOf(s->startInterp, tpos);
+        tpos = translation.indexOf(Statics::startInterp, tpos);
     }
     // Last text segment.
-    finalTranslation.append(substituteSimple(scriptedTranslation.mid(ppos), arguments, s->scriptPlchar, true));
+    pieces.append({KPlaceholderTemplate(translation.mid(ppos), Statics::scriptPlchar), -1});
+}
 
-    // Return empty string if fallback was requested.
-    return fallback ? QString() : finalTranslation;
+// Index of the value referenced by a free segment,
+// -1 if the segment is not a proper value reference.
+static int valueReferenceIndex(const QString &segment)
+{
+    // Value reference must start with a special character.
+    if (!segment.startsWith(KLocalizedStringPrivateStatics::scriptVachar)) {
+        return -1;
+    }
+
+    // Reference number must start with 1-9.
+    // (If numstr is empty, toInt() will return 0.)
+    QString numstr = segment.mid(1);
+    int numstrAsInt = QStringView(numstr).left(1).toInt();
+    if (numstrAsInt < 1) {
+        return -1;
+    }
+
+    // Number must be valid.
+    bool ok;
+    int index = numstr.toInt(&ok) - 1;
+    return ok ? index : -1;
 }
 
-qsizetype KLocalizedStringPrivate::resolveInterpolation(const QString &scriptedTranslation,
-                                                        qsizetype pos,
-                                                        const QString &language,
-                                                        const QString &country,
-                                                        const QString &ordinaryTranslation,
-                                                        const QStringList &arguments,
-                                                        const QList<QVariant> &values,
-                                                        QString &result,
-                                                        bool &fallback) const
+qsizetype KTranscriptTemplate::parseInterpolation(qsizetype pos, int &index)
 {
     // pos is the position of opening character sequence.
     // Returns the position of first character after closing sequence,
     // or -1 in case of parsing error.
-    // result is set to result of Transcript evaluation.
-    // fallback is set to true if Transcript evaluation requested so.
-
-    KLocalizedStringPrivateStatics *s = staticsKLSP();
+    // index is set to the index of the parsed interpolation.
 
-    result.clear();
-    fallback = false;
+    using Statics = KLocalizedStringPrivateStatics;
 
     // Split interpolation into arguments.
-    QList<QVariant> iargs;
-    const qsizetype slen = scriptedTranslation.length();
-    const qsizetype islen = s->startInterp.length();
-    const qsizetype ielen = s->endInterp.length();
-    qsizetype tpos = pos + s->startInterp.length();
+    Interpolation interpolation;
+    const qsizetype slen = translation.length();
+    const qsizetype islen = Statics::startInterp.length();
+    const qsizetype ielen = Statics::endInterp.length();
+    qsizetype tpos = pos + Statics::startInterp.length();
     while (1) {
         // Skip whitespace.
-        while (tpos < slen && scriptedTranslation[tpos].isSpace()) {
+        while (tpos < slen && translation[tpos].isSpace()) {
             ++tpos;
         }
         if (tpos == slen) {
-            qCWarning(KI18N) << "Unclosed interpolation" << scriptedTranslation.mid(pos, tpos - pos) << "in message" << shortenMessage(scriptedTranslation);
+            qCWarning(KI18N) << "Unclosed interpolation" << translation.mid(pos, tpos - pos) << "in message" << shortenMessage(translation);
             return -1;
         }
-        if (QStringView(scriptedTranslation).mid(tpos, ielen) == s->endInterp) {
+        if (QStringView(translation).mid(tpos, ielen) == Statics::endInterp) {
             break; // no more arguments
         }
 
         // Parse argument: may be concatenated from free and quoted text,
         // and sub-interpolations.
-        // Free and quoted segments may contain placeholders, substitute them;
-        // recurse into sub-interpolations.
-        // Free segments may be value references, parse and record for
-        // consideration at the end.
+        // Free and quoted segments may contain placeholders, to be substituted;
+        // sub-interpolations are parsed recursively.
+        // Free segments may be value references, record which value
+        // they would reference for consideration at evaluation.
         // Mind backslash escapes throughout.
-        QStringList segs;
-        QVariant vref;
-        while (!scriptedTranslation[tpos].isSpace() && scriptedTranslation.mid(tpos, ielen) != s->endInterp) {
-            if (scriptedTranslation[tpos] == QLatin1Char('\'')) { // quoted segment
+        QList<Segment> segs;
+        while (!translation[tpos].isSpace() && translation.mid(tpos, ielen) != Statics::endInterp) {
+            if (translation[tpos] == QLatin1Char('\'')) { // quoted segment
                 QString seg;
                 ++tpos; // skip opening quote
                 // Find closing quote.
-                while (tpos < slen && scriptedTranslation[tpos] != QLatin1Char('\'')) {
-                    if (scriptedTranslation[tpos] == QLatin1Char('\\')) {
+                while (tpos < slen && translation[tpos] != QLatin1Char('\'')) {
+                    if (translation[tpos] == QLatin1Char('\\')) {
                         ++tpos; // escape next character
                     }
-                    seg.append(scriptedTranslation[tpos]);
+                    seg.append(translation[tpos]);
                     ++tpos;
                 }
                 if (tpos == slen) {
-                    qCWarning(KI18N) << "Unclosed quote in interpolation" << scriptedTranslation.mid(pos, tpos - pos) << "in message"
-                                     << shortenMessage(scriptedTranslation);
+                    qCWarning(KI18N) << "Unclosed quote in interpolation" << translation.mid(pos, tpos - pos) << "in message"
+                                     << shortenMessage(translation);
                     return -1;
                 }
 
-                // Append to list of segments, resolving placeholders.
-                segs.append(substituteSimple(seg, arguments, s->scriptPlchar, true));
+                segs.append({Segment::Quoted, -1, KPlaceholderTemplate(seg, Statics::scriptPlchar)});
 
                 ++tpos; // skip closing quote
-            } else if (scriptedTranslation.mid(tpos, islen) == s->startInterp) { // sub-interpolation
-                QString resultLocal;
-                bool fallbackLocal;
-                tpos = resolveInterpolation(scriptedTranslation, tpos, language, country, ordinaryTranslation, arguments, values, resultLocal, fallbackLocal);
+            } else if (translation.mid(tpos, islen) == Statics::startInterp) { // sub-interpolation
+                int subIndex;
+                tpos = parseInterpolation(tpos, subIndex);
                 if (tpos < 0) { // unrecoverable problem in sub-interpolation
                     // Error reported in the subcall.
                     return tpos;
                 }
-                if (fallbackLocal) { // sub-interpolation requested fallback
-                    fallback = true;
-                }
-                segs.append(resultLocal);
+                segs.append({Segment::Interpolation, subIndex, KPlaceholderTemplate(QString())});
             } else { // free segment
                 QString seg;
                 // Find whitespace, quote, opening or closing sequence.
-                while (tpos < slen && !scriptedTranslation[tpos].isSpace() //
-                       && scriptedTranslation[tpos] != QLatin1Char('\'') //
-                       && scriptedTranslation.mid(tpos, islen) != s->startInterp //
-                       && scriptedTranslation.mid(tpos, ielen) != s->endInterp) {
-                    if (scriptedTranslation[tpos] == QLatin1Char('\\')) {
+                while (tpos < slen && !translation[tpos].isSpace() //
+                       && translation[tpos] != QLatin1Char('\'') //
+                       && translation.mid(tpos, islen) != Statics::startInterp //
+                       && translation.mid(tpos, ielen) != Statics::endInterp) {
+                    if (translation[tpos] == QLatin1Char('\\')) {
                         ++tpos; // escape next character
                     }
-                    seg.append(scriptedTranslation[tpos]);
+                    seg.append(translation[tpos]);
                     ++tpos;
                 }
                 if (tpos == slen) {
-                    qCWarning(KI18N) << "Non-terminated interpolation" << scriptedTranslation.mid(pos, tpos - pos) << "in message"
-                                     << shortenMessage(scriptedTranslation);
+                    qCWarning(KI18N) << "Non-terminated interpolation" << translation.mid(pos, tpos - pos) << "in message" << shortenMessage(translation);
                     return -1;
                 }
 
-                // The free segment may look like a value reference;
-                // in that case, record which value it would reference,
-                // and add verbatim to the segment list.
-                // Otherwise, do a normal substitution on the segment.
-                vref = segmentToValue(seg);
-                if (vref.isValid()) {
-                    segs.append(seg);
-                } else {
-                    segs.append(substituteSimple(seg, arguments, s->scriptPlchar, true));
-                }
+                segs.append({Segment::Free, valueReferenceIndex(seg), KPlaceholderTemplate(seg, Statics::scriptPlchar)});
             }
         }
 
-        // Append this argument to rest of the arguments.
-        // If the there was a single text segment and it was a proper value
-        // reference, add it instead of the joined segments.
-        // Otherwise, add the joined segments.
-        if (segs.size() == 1 && vref.isValid()) {
-            iargs.append(vref);
-        } else {
-            iargs.append(segs.join(QString()));
-        }
+        interpolation.arguments.append(segs);
     }
     tpos += ielen; // skip to first character after closing sequence
 
@@ -962,68 +1335,196 @@ qsizetype KLocalizedStringPrivate::resolveInterpolation(const QString &scriptedT
     // there is the danger of substituted text or sub-interpolations producing
     // quotes and escapes themselves, which would mess up the parsing.
 
+    interpolation.source = translation.mid(pos, tpos - pos);
+    index = interpolations.size();
+    interpolations.append(interpolation);
+    return tpos;
+}
+
+// Scripting modules which the interpreters of the calling thread
+// have not been given to load yet.
+static QList<QStringList> takeScriptModulesToLoad()
+{
+    KLocalizedStringPrivateStatics *s = staticsKLSP();
+
+    thread_local qsizetype numLoaded = 0;
+
+    QMutexLocker lock(&s->klspMutex);
+    QList<QStringList> modules = s->scriptModulesToLoad.mid(numLoaded);
+    numLoaded = s->scriptModulesToLoad.size();
+    return modules;
+}
+
+QString KLocalizedStringPrivate::substituteTranscript(const QString &scriptedTranslation,
+                                                      const QString &language,
+                                                      const QString &country,
+                                                      const QString &ordinaryTranslation,
+                                                      const QStringList &arguments,
+                                                      const QList<QVariant> &values,
+                                                      bool &fallback) const
+{
+    KLocalizedStringPrivateStatics *s = staticsKLSP();
+
+    if (!s->ktrs.loadRelaxed()) {
+        // Scripting engine not available.
+        return QString();
+    }
+
+    // Scripted translations are parsed once, then only evaluated.
+    // Those which cannot be parsed are not remembered,
+    // so that they are reported every time.
+    thread_local QCache<QString, KTranscriptTemplate> scriptTemplates{1024};
+    const KTranscriptTemplate *translationTemplate = scriptTemplates.object(scriptedTranslation);
+    if (!translationTemplate) {
+        auto parsedTemplate = std::make_unique<KTranscriptTemplate>(scriptedTranslation);
+        if (!parsedTemplate->isValid) {
+            return QString();
+        }
+        translationTemplate = parsedTemplate.get();
+        scriptTemplates.insert(scriptedTranslation, parsedTemplate.release());
+    }
+
+    const QString msgctxt = QString::fromUtf8(context);
+    const QString msgid = QString::fromUtf8(text);
+
+    // Iterate by interpolations.
+    QString finalTranslation;
+    fallback = false;
+    for (const KTranscriptTemplate::Piece &piece : translationTemplate->pieces) {
+        // Resolve substitutions in preceding text.
+        finalTranslation.append(substituteSimple(piece.text, arguments, true));
+        if (piece.interpolation < 0) {
+            break;
+        }
+
+        // Resolve interpolation.
+        bool fallbackLocal;
+        const QString result = resolveInterpolation(*translationTemplate,
+                                                     piece.interpolation,
+                                                     language,
+                                                     country,
+                                                     msgctxt,
+                                                     msgid,
+                                                     ordinaryTranslation,
+                                                     arguments,
+                                                     values,
+                                                     fallbackLocal);
+
+        // If fallback has been explicitly requested, indicate global fallback
+        // but proceed with evaluations (other interpolations may set states).
+        if (fallbackLocal) {
+            fallback = true;
+        }
+
+        // Add evaluated interpolation to the text.
+        finalTranslation.append(result);
+    }
+
+    // Return empty string if fallback was requested.
+    return fallback ? QString() : finalTranslation;
+}
+
+QString KLocalizedStringPrivate::resolveInterpolation(const KTranscriptTemplate &translationTemplate,
+                                                      int index,
+                                                      const QString &language,
+                                                      const QString &country,
+                                                      const QString &msgctxt,
+                                                      const QString &msgid,
+                                                      const QString &ordinaryTranslation,
+                                                      const QStringList &arguments,
+                                                      const QList<QVariant> &values,
+                                                      bool &fallback) const
+{
+    // Returns the result of Transcript evaluation.
+    // fallback is set to true if Transcript evaluation requested so.
+
+    KLocalizedStringPrivateStatics *s = staticsKLSP();
+
+    fallback = false;
+
+    const KTranscriptTemplate::Interpolation &interpolation = translationTemplate.interpolations.at(index);
+
+    // Resolve arguments of the interpolation.
+    QList<QVariant> iargs;
+    iargs.reserve(interpolation.arguments.size());
+    for (const QList<KTranscriptTemplate::Segment> &segs : interpolation.arguments) {
+        // If the there was a single text segment and it was a proper value
+        // reference, add the value instead of the joined segments.
+        if (segs.size() == 1) {
+            const QVariant vref = segmentToValue(segs.first());
+            if (vref.isValid()) {
+                iargs.append(vref);
+                continue;
+            }
+        }
+
+        // Otherwise, add the joined segments, with placeholders substituted
+        // and sub-interpolations evaluated. Free segments which are proper
+        // value references are added verbatim.
+        QString iarg;
+        for (const KTranscriptTemplate::Segment &seg : segs) {
+            if (seg.type == KTranscriptTemplate::Segment::Interpolation) {
+                bool fallbackLocal;
+                iarg.append(resolveInterpolation(translationTemplate,
+                                                 seg.index,
+                                                 language,
+                                                 country,
+                                                 msgctxt,
+                                                 msgid,
+                                                 ordinaryTranslation,
+                                                 arguments,
+                                                 values,
+                                                 fallbackLocal));
+                if (fallbackLocal) { // sub-interpolation requested fallback
+                    fallback = true;
+                }
+            } else if (segmentToValue(seg).isValid()) {
+                iarg.append(seg.text.translation);
+            } else {
+                iarg.append(substituteSimple(seg.text, arguments, true));
+            }
+        }
+        iargs.append(iarg);
+    }
+
     // Evaluate interpolation.
-    QString msgctxt = QString::fromUtf8(context);
-    QString msgid = QString::fromUtf8(text);
+    QList<QStringList> modules = takeScriptModulesToLoad();
     QString scriptError;
     bool fallbackLocal;
-    result = s->ktrs->eval(iargs,
-                           language,
-                           country,
-                           msgctxt,
-                           dynamicContext,
-                           msgid,
-                           arguments,
-                           values,
-                           ordinaryTranslation,
-                           s->scriptModulesToLoad,
-                           scriptError,
-                           fallbackLocal);
-    // s->scriptModulesToLoad will be cleared during the call.
+    const QString result = s->ktrs.loadRelaxed()->eval(iargs,
+                                                       language,
+                                                       country,
+                                                       msgctxt,
+                                                       dynamicContext,
+                                                       msgid,
+                                                       arguments,
+                                                       values,
+                                                       ordinaryTranslation,
+                                                       modules,
+                                                       scriptError,
+                                                       fallbackLocal);
 
     if (fallbackLocal) { // evaluation requested fallback
         fallback = true;
     }
     if (!scriptError.isEmpty()) { // problem with evaluation
         fallback = true; // also signal fallback
-        if (!scriptError.isEmpty()) {
-            qCWarning(KI18N) << "Interpolation" << scriptedTranslation.mid(pos, tpos - pos) << "in" << shortenMessage(scriptedTranslation)
-                             << "failed:" << scriptError;
-        }
+        qCWarning(KI18N) << "Interpolation" << interpolation.source << "in" << shortenMessage(translationTemplate.translation) << "failed:" << scriptError;
     }
 
-    return tpos;
+    return result;
 }
 
-QVariant KLocalizedStringPrivate::segmentToValue(const QString &segment) const
+QVariant KLocalizedStringPrivate::segmentToValue(const KTranscriptTemplate::Segment &segment) const
 {
-    KLocalizedStringPrivateStatics *s = staticsKLSP();
-
     // Return invalid variant if segment is either not a proper
     // value reference, or the reference is out of bounds.
-
-    // Value reference must start with a special character.
-    if (!segment.startsWith(s->scriptVachar)) {
-        return QVariant();
-    }
-
-    // Reference number must start with 1-9.
-    // (If numstr is empty, toInt() will return 0.)
-    QString numstr = segment.mid(1);
-    int numstrAsInt = QStringView(numstr).left(1).toInt();
-    if (numstrAsInt < 1) {
-        return QVariant();
-    }
-
-    // Number must be valid and in bounds.
-    bool ok;
-    int index = numstr.toInt(&ok) - 1;
-    if (!ok || index >= values.size()) {
+    if (segment.type != KTranscriptTemplate::Segment::Free || segment.index < 0 || segment.index >= arguments.size()) {
         return QVariant();
     }
 
     // Passed all hoops.
-    return values.at(index);
+    return arguments.at(segment.index).value();
 }
 
 QString KLocalizedStringPrivate::postTranscript(const QString &pcall,
@@ -1035,7 +1536,7 @@ QString KLocalizedStringPrivate::postTranscript(const QString &pcall,
 {
     KLocalizedStringPrivateStatics *s = staticsKLSP();
 
-    if (s->ktrs == nullptr) {
+    if (!s->ktrs.loadRelaxed()) {
         // Scripting engine not available.
         // (Though this cannot happen, we wouldn't be here then.)
         return QString();
@@ -1046,10 +1547,10 @@ QString KLocalizedStringPrivate::postTranscript(const QString &pcall,
     iargs.append(pcall);
     QString msgctxt = QString::fromUtf8(context);
     QString msgid = QString::fromUtf8(text);
+    QList<QStringList> modules = takeScriptModulesToLoad();
     QString scriptError;
     bool fallback;
-    s->ktrs->eval(iargs, language, country, msgctxt, dynamicContext, msgid, arguments, values, finalTranslation, s->scriptModulesToLoad, scriptError, fallback);
-    // s->scriptModulesToLoad will be cleared during the call.
+    s->ktrs.loadRelaxed()->eval(iargs, language, country, msgctxt, dynamicContext, msgid, arguments, values, finalTranslation, modules, scriptError, fallback);
 
     // If the evaluation went wrong.
     if (!scriptError.isEmpty()) {
@@ -1063,117 +1564,91 @@ QString KLocalizedStringPrivate::postTranscript(const QString &pcall,
 KLocalizedString KLocalizedString::withLanguages(const QStringList &languages) const
 {
     KLocalizedString kls(*this);
-    kls.d->languages = languages;
+    kls.replaceLanguages(languages);
     return kls;
 }
 
 KLocalizedString KLocalizedString::withDomain(const char *domain) const
 {
     KLocalizedString kls(*this);
-    kls.d->domain = domain;
+    kls.replaceDomain(domain);
     return kls;
 }
 
 KLocalizedString KLocalizedString::withFormat(Kuit::VisualFormat format) const
 {
     KLocalizedString kls(*this);
-    kls.d->format = format;
+    kls.replaceFormat(format);
     return kls;
 }
 
 KLocalizedString KLocalizedString::subs(int a, int fieldWidth, int base, QChar fillChar) const
 {
     KLocalizedString kls(*this);
-    kls.d->checkNumber(std::abs(a));
-    kls.d->arguments.append(QStringLiteral("%L1").arg(a, fieldWidth, base, fillChar));
-    kls.d->values.append(static_cast<intn>(a));
+    kls.substitute(a, fieldWidth, base, fillChar);
     return kls;
 }
 
 KLocalizedString KLocalizedString::subs(uint a, int fieldWidth, int base, QChar fillChar) const
 {
     KLocalizedString kls(*this);
-    kls.d->checkNumber(a);
-    kls.d->arguments.append(QStringLiteral("%L1").arg(a, fieldWidth, base, fillChar));
-    kls.d->values.append(static_cast<uintn>(a));
+    kls.substitute(a, fieldWidth, base, fillChar);
     return kls;
 }
 
 KLocalizedString KLocalizedString::subs(long a, int fieldWidth, int base, QChar fillChar) const
 {
     KLocalizedString kls(*this);
-    kls.d->checkNumber(std::abs(a));
-    kls.d->arguments.append(QStringLiteral("%L1").arg(a, fieldWidth, base, fillChar));
-    kls.d->values.append(static_cast<intn>(a));
+    kls.substitute(a, fieldWidth, base, fillChar);
     return kls;
 }
 
 KLocalizedString KLocalizedString::subs(ulong a, int fieldWidth, int base, QChar fillChar) const
 {
     KLocalizedString kls(*this);
-    kls.d->checkNumber(a);
-    kls.d->arguments.append(QStringLiteral("%L1").arg(a, fieldWidth, base, fillChar));
-    kls.d->values.append(static_cast<uintn>(a));
+    kls.substitute(a, fieldWidth, base, fillChar);
     return kls;
 }
 
 KLocalizedString KLocalizedString::subs(qlonglong a, int fieldWidth, int base, QChar fillChar) const
 {
     KLocalizedString kls(*this);
-    kls.d->checkNumber(qAbs(a));
-    kls.d->arguments.append(QStringLiteral("%L1").arg(a, fieldWidth, base, fillChar));
-    kls.d->values.append(static_cast<intn>(a));
+    kls.substitute(a, fieldWidth, base, fillChar);
     return kls;
 }
 
 KLocalizedString KLocalizedString::subs(qulonglong a, int fieldWidth, int base, QChar fillChar) const
 {
     KLocalizedString kls(*this);
-    kls.d->checkNumber(a);
-    kls.d->arguments.append(QStringLiteral("%L1").arg(a, fieldWidth, base, fillChar));
-    kls.d->values.append(static_cast<uintn>(a));
+    kls.substitute(a, fieldWidth, base, fillChar);
     return kls;
 }
 
 KLocalizedString KLocalizedString::subs(double a, int fieldWidth, char format, int precision, QChar fillChar) const
 {
     KLocalizedString kls(*this);
-    kls.d->arguments.append(QStringLiteral("%L1").arg(a, fieldWidth, format, precision, fillChar));
-    kls.d->values.append(static_cast<realn>(a));
+    kls.substitute(a, fieldWidth, format, precision, fillChar);
     return kls;
 }
 
 KLocalizedString KLocalizedString::subs(QChar a, int fieldWidth, QChar fillChar) const
 {
     KLocalizedString kls(*this);
-    QString baseArg = QString(a);
-    QString fmtdArg = QStringLiteral("%1").arg(a, fieldWidth, fillChar);
-    kls.d->arguments.append(fmtdArg);
-    kls.d->values.append(baseArg);
+    kls.substitute(a, fieldWidth, fillChar);
     return kls;
 }
 
 KLocalizedString KLocalizedString::subs(const QString &a, int fieldWidth, QChar fillChar) const
 {
     KLocalizedString kls(*this);
-    QString baseArg = a;
-    QString fmtdArg = QStringLiteral("%1").arg(a, fieldWidth, fillChar);
-    kls.d->arguments.append(fmtdArg);
-    kls.d->values.append(baseArg);
+    kls.substitute(a, fieldWidth, fillChar);
     return kls;
 }
 
 KLocalizedString KLocalizedString::subs(const KLocalizedString &a, int fieldWidth, QChar fillChar) const
 {
     KLocalizedString kls(*this);
-    // KLocalizedString arguments must be resolved inside toString
-    // when the domain, language, visual format, etc. become known.
-    int i = kls.d->arguments.size();
-    kls.d->klsArguments[i] = a;
-    kls.d->klsArgumentFieldWidths[i] = fieldWidth;
-    kls.d->klsArgumentFillChars[i] = fillChar;
-    kls.d->arguments.append(QString());
-    kls.d->values.append(0);
+    kls.substitute(a, fieldWidth, fillChar);
     return kls;
 }
 
@@ -1198,6 +1673,116 @@ KLocalizedString KLocalizedString::ignoreMarkup() const
     return kls;
 }
 
+void KLocalizedString::replaceLanguages(const QStringList &languages)
+{
+    d->languages = languages;
+}
+
+void KLocalizedString::replaceDomain(const char *domain)
+{
+    d->domain = domain;
+}
+
+void KLocalizedString::replaceFormat(Kuit::VisualFormat format)
+{
+    d->format = format;
+}
+
+void KLocalizedString::substitute(int a, int fieldWidth, int base, QChar fillChar)
+{
+    d->checkNumber(std::abs(a));
+    KLocalizedStringArgument &argument = d->arguments.emplace_back();
+    argument.text = QStringLiteral("%L1").arg(a, fieldWidth, base, fillChar);
+    argument.type = KLocalizedStringArgument::Signed;
+    argument.signedNumber = static_cast<intn>(a);
+}
+
+void KLocalizedString::substitute(uint a, int fieldWidth, int base, QChar fillChar)
+{
+    d->checkNumber(a);
+    KLocalizedStringArgument &argument = d->arguments.emplace_back();
+    argument.text = QStringLiteral("%L1").arg(a, fieldWidth, base, fillChar);
+    argument.type = KLocalizedStringArgument::Unsigned;
+    argument.unsignedNumber = static_cast<uintn>(a);
+}
+
+void KLocalizedString::substitute(long a, int fieldWidth, int base, QChar fillChar)
+{
+    d->checkNumber(std::abs(a));
+    KLocalizedStringArgument &argument = d->arguments.emplace_back();
+    argument.text = QStringLiteral("%L1").arg(a, fieldWidth, base, fillChar);
+    argument.type = KLocalizedStringArgument::Signed;
+    argument.signedNumber = static_cast<intn>(a);
+}
+
+void KLocalizedString::substitute(ulong a, int fieldWidth, int base, QChar fillChar)
+{
+    d->checkNumber(a);
+    KLocalizedStringArgument &argument = d->arguments.emplace_back();
+    argument.text = QStringLiteral("%L1").arg(a, fieldWidth, base, fillChar);
+    argument.type = KLocalizedStringArgument::Unsigned;
+    argument.unsignedNumber = static_cast<uintn>(a);
+}
+
+void KLocalizedString::substitute(qlonglong a, int fieldWidth, int base, QChar fillChar)
+{
+    d->checkNumber(qAbs(a));
+    KLocalizedStringArgument &argument = d->arguments.emplace_back();
+    argument.text = QStringLiteral("%L1").arg(a, fieldWidth, base, fillChar);
+    argument.type = KLocalizedStringArgument::Signed;
+    argument.signedNumber = static_cast<intn>(a);
+}
+
+void KLocalizedString::substitute(qulonglong a, int fieldWidth, int base, QChar fillChar)
+{
+    d->checkNumber(a);
+    KLocalizedStringArgument &argument = d->arguments.emplace_back();
+    argument.text = QStringLiteral("%L1").arg(a, fieldWidth, base, fillChar);
+    argument.type = KLocalizedStringArgument::Unsigned;
+    argument.unsignedNumber = static_cast<uintn>(a);
+}
+
+void KLocalizedString::substitute(double a, int fieldWidth, char format, int precision, QChar fillChar)
+{
+    KLocalizedStringArgument &argument = d->arguments.emplace_back();
+    argument.text = QStringLiteral("%L1").arg(a, fieldWidth, format, precision, fillChar);
+    argument.type = KLocalizedStringArgument::Real;
+    argument.realNumber = static_cast<realn>(a);
+}
+
+void KLocalizedString::substitute(QChar a, int fieldWidth, QChar fillChar)
+{
+    KLocalizedStringArgument &argument = d->arguments.emplace_back();
+    if (fieldWidth != 0) {
+        argument.text = QStringLiteral("%1").arg(a, fieldWidth, fillChar);
+        argument.string = QString(a);
+    } else {
+        argument.text = QString(a);
+    }
+}
+
+void KLocalizedString::substitute(const QString &a, int fieldWidth, QChar fillChar)
+{
+    KLocalizedStringArgument &argument = d->arguments.emplace_back();
+    if (fieldWidth != 0) {
+        argument.text = QStringLiteral("%1").arg(a, fieldWidth, fillChar);
+        argument.string = a;
+    } else {
+        argument.text = a;
+    }
+}
+
+void KLocalizedString::substitute(const KLocalizedString &a, int fieldWidth, QChar fillChar)
+{
+    // KLocalizedString arguments must be resolved inside toString
+    // when the domain, language, visual format, etc. become known.
+    KLocalizedStringArgument &argument = d->arguments.emplace_back();
+    argument.message = std::make_shared<const KLocalizedString>(a);
+    argument.fieldWidth = fieldWidth;
+    argument.fillChar = fillChar;
+    argument.type = KLocalizedStringArgument::Message;
+}
+
 QByteArray KLocalizedString::untranslatedText() const
 {
     return d->text;
@@ -1210,20 +1795,39 @@ void KLocalizedString::setApplicationDomain(const QByteArray &domain)
     QMutexLocker lock(&s->klspMutex);
 
     s->applicationDomain = domain;
+    s->settingsGeneration.ref();
 }
 
 QByteArray KLocalizedString::applicationDomain()
 {
-    KLocalizedStringPrivateStatics *s = staticsKLSP();
-
-    return s->applicationDomain;
+    return threadData().applicationDomain;
 }
 
 QStringList KLocalizedString::languages()
 {
-    KLocalizedStringPrivateStatics *s = staticsKLSP();
+    return threadData().languages;
+}
+
+KLocalizedScope::KLocalizedScope(const QStringList &languages, const QByteArray &domain)
+    : d(new KLocalizedScopePrivate)
+{
+    KLocalizedStringThreadData &data = threadData();
+    d->previousDomain = data.scopeDomain;
+    d->previousLanguages = data.scopeLanguages;
+    if (!domain.isEmpty()) {
+        data.scopeDomain = domain;
+    }
+    if (!languages.isEmpty()) {
+        data.scopeLanguages = languages;
+    }
+}
 
-    return s->languages;
+KLocalizedScope::~KLocalizedScope()
+{
+    KLocalizedStringThreadData &data = threadData();
+    data.scopeDomain = d->previousDomain;
+    data.scopeLanguages = d->previousLanguages;
+    delete d;
 }
 
 void KLocalizedString::setLanguages(const QStringList &languages)
@@ -1233,6 +1837,7 @@ void KLocalizedString::setLanguages(const QStringList &languages)
     QMutexLocker lock(&s->klspMutex);
 
     s->languages = languages;
+    s->settingsGeneration.ref();
 }
 
 void KLocalizedString::clearLanguages()
@@ -1242,18 +1847,19 @@ void KLocalizedString::clearLanguages()
     QMutexLocker lock(&s->klspMutex);
 
     s->languages = s->localeLanguages;
+    s->settingsGeneration.ref();
 }
 
 bool KLocalizedString::isApplicationTranslatedInto(const QString &language)
 {
     KLocalizedStringPrivateStatics *s = staticsKLSP();
 
-    return language == s->codeLanguage || !KCatalog::catalogLocaleDir(s->applicationDomain, language).isEmpty();
+    return language == s->codeLanguage || !KCatalog::catalogLocaleDir(applicationDomain(), language).isEmpty();
 }
 
 QSet<QString> KLocalizedString::availableApplicationTranslations()
 {
-    return availableDomainTranslations(staticsKLSP()->applicationDomain);
+    return availableDomainTranslations(applicationDomain());
 }
 
 QSet<QString> KLocalizedString::availableDomainTranslations(const QByteArray &domain)
@@ -1270,6 +1876,11 @@ QSet<QString> KLocalizedString::availableDomainTranslations(const QByteArray &do
 
 const KCatalog &KLocalizedStringPrivate::getCatalog(const QByteArray &domain, const QString &language)
 {
+    KCatalogPtrHash &threadCatalogs = threadData().catalogs[domain];
+    if (const KCatalog *catalog = threadCatalogs.value(language)) {
+        return *catalog;
+    }
+
     KLocalizedStringPrivateStatics *s = staticsKLSP();
 
     QMutexLocker lock(&s->klspMutex);
@@ -1283,6 +1894,7 @@ const KCatalog &KLocalizedStringPrivate::getCatalog(const QByteArray &domain, co
         catalog = languageCatalogs->insert(language, new KCatalog(domain, language));
         locateScriptingModule(domain, language);
     }
+    threadCatalogs.insert(language, *catalog);
     return **catalog;
 }
 
@@ -1324,10 +1936,10 @@ void KLocalizedStringPrivate::loadTranscript()
     QMutexLocker lock(&s->klspMutex);
 
     s->loadTranscriptCalled = true;
-    s->ktrs = nullptr; // null indicates that Transcript is not available
+    s->ktrs.storeRelease(nullptr); // null indicates that Transcript is not available
 
 #if HAVE_STATIC_KTRANSCRIPT
-    s->ktrs = load_transcript();
+    s->ktrs.storeRelease(load_transcript());
 #else
     // QPluginLoader is just used to find the plugin
     QPluginLoader loader(QStringLiteral("kf6/ktranscript"));
@@ -1349,14 +1961,73 @@ void KLocalizedStringPrivate::loadTranscript()
         return;
     }
 
-    s->ktrs = initf();
+    s->ktrs.storeRelease(initf());
 #endif
 }
 
-QString KLocalizedString::localizedFilePath(const QString &filePath)
+bool KLocalizedString::warmUpTranscript()
 {
     KLocalizedStringPrivateStatics *s = staticsKLSP();
 
+    const KLocalizedStringThreadData &data = threadData();
+    // The domain of the calling thread, as set by any KLocalizedScope.
+    const QByteArray domain = data.domain();
+    QStringList languages;
+    for (const QString &language : data.translationLanguages()) {
+        const QString scriptDirPath = QStandardPaths::locate(QStandardPaths::GenericDataLocation,
+                                                             QLatin1String("locale/%1/%2").arg(language, s->scriptDir),
+                                                             QStandardPaths::LocateDirectory);
+        if (!scriptDirPath.isEmpty()) {
+            languages.append(language);
+        }
+    }
+    if (languages.isEmpty()) {
+        return false;
+    }
+
+    // Loading the plugin and the catalogs, which locates
+    // their scripting modules, can be done in any thread.
+    QThread *thread = QThread::create([s, domain, languages]() {
+        {
+            QMutexLocker lock(&s->klspMutex);
+            if (!s->loadTranscriptCalled) {
+                KLocalizedStringPrivate::loadTranscript();
+            }
+        }
+        for (const QString &language : languages) {
+            KLocalizedStringPrivate::getCatalog(s->ourDomain, language);
+            if (!domain.isEmpty()) {
+                KLocalizedStringPrivate::getCatalog(domain, language);
+            }
+        }
+    });
+
+    // The thread object lives in the calling thread, so the interpreters
+    // are set up there, by evaluating an empty interpolation.
+    QObject::connect(thread, &QThread::finished, thread, [s, languages]() {
+        KTranscript *ktrs = s->ktrs.loadAcquire();
+        if (!ktrs) {
+            return;
+        }
+        QList<QStringList> modules = takeScriptModulesToLoad();
+        const QHash<QString, QString> dynamicContext;
+        for (const QString &language : languages) {
+            QString scriptError;
+            bool fallback;
+            ktrs->eval({}, language, QString(), QString(), dynamicContext, QString(), {}, {}, QString(), modules, scriptError, fallback);
+            if (!scriptError.isEmpty()) {
+                qCWarning(KI18N) << "Loading scripting modules failed:" << scriptError;
+            }
+        }
+    });
+    QObject::connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    thread->start();
+
+    return true;
+}
+
+QString KLocalizedString::localizedFilePath(const QString &filePath)
+{
     // Check if l10n subdirectory is present, stop if not.
     QFileInfo fileInfo(filePath);
     QString locDirPath = fileInfo.path() + QLatin1Char('/') + QLatin1String("l10n");
@@ -1368,7 +2039,7 @@ QString KLocalizedString::localizedFilePath(const QString &filePath)
     // Go through possible localized paths by priority of languages,
     // return first that exists.
     QString fileName = fileInfo.fileName();
-    for (const QString &lang : std::as_const(s->languages)) {
+    for (const QString &lang : threadData().translationLanguages()) {
         QString locFilePath = locDirPath + QLatin1Char('/') + lang + QLatin1Char('/') + fileName;
         QFileInfo locFileInfo(locFilePath);
         if (locFileInfo.isFile() && locFileInfo.isReadable()) {
@@ -1386,7 +2057,19 @@ QString KLocalizedString::removeAcceleratorMarker(const QString &label)
 
 void KLocalizedString::addDomainLocaleDir(const QByteArray &domain, const QString &path)
 {
+    KLocalizedStringPrivateStatics *s = staticsKLSP();
+
+    QMutexLocker lock(&s->klspMutex);
+
     KCatalog::addDomainLocaleDir(domain, path);
+
+    // Catalogs of the domain are looked up anew, in the added directory.
+    const auto languageCatalogs = s->catalogs.constFind(domain);
+    if (languageCatalogs != s->catalogs.cend()) {
+        s->retiredCatalogs.append(languageCatalogs->values());
+        s->catalogs.erase(languageCatalogs);
+    }
+    s->settingsGeneration.ref();
 }
 
 KLocalizedString ki18n(const char *text)
@@ -11,17 +11,28 @@
 #include <QChar>
 #include <QLatin1Char>
 #include <QSet>
+#include <QSpan>
 #include <QString>
 #include <QStringList>
 
 #include <kuitsetup.h>
 
+#include <utility>
+
 // enforce header to be parsed before redefining i18n* with preprocessor macros
 // depending on TRANSLATION_DOMAIN (see bottom of file)
 #include <klocalizedcontext.h>
 
 class KLocalizedStringPrivate;
 class KLazyLocalizedString;
+class KLocalizedString;
+class KLocalizedScopePrivate;
+
+namespace KI18nPrivate
+{
+template<typename... Args>
+KLocalizedString subs(KLocalizedString &&message, const Args &...args);
+}
 
 /*!
  * \class KLocalizedString
@@ -43,6 +54,9 @@ class KI18N_EXPORT KLocalizedString
     friend class KLocalizedStringPrivate;
     friend class KLazyLocalizedString;
 
+    template<typename... Args>
+    friend KLocalizedString KI18nPrivate::subs(KLocalizedString &&message, const Args &...args);
+
     friend KLocalizedString KI18N_EXPORT ki18n(const char *text);
     friend KLocalizedString KI18N_EXPORT ki18nc(const char *context, const char *text);
     friend KLocalizedString KI18N_EXPORT ki18np(const char *singular, const char *plural);
@@ -79,6 +93,22 @@ public:
 
     KLocalizedString &operator=(const KLocalizedString &rhs);
 
+    /*!
+     * Move constructor.
+     *
+     * The moved-from message can only be assigned to or destroyed.
+     *
+     * \since 6.30
+     */
+    KLocalizedString(KLocalizedString &&rhs) noexcept;
+
+    /*!
+     * Move assignment operator.
+     *
+     * \since 6.30
+     */
+    KLocalizedString &operator=(KLocalizedString &&rhs) noexcept;
+
     ~KLocalizedString();
 
     /*!
@@ -147,6 +177,23 @@ public:
      */
     Q_REQUIRED_RESULT QString toString(Kuit::VisualFormat format) const;
 
+    /*!
+     * Finalize the translations of several messages at once.
+     *
+     * This gives the same translations as calling toString on each message,
+     * but the current languages and application domain are looked up
+     * only once, which makes translating long tables faster.
+     *
+     * \a messages the messages to translate
+     *
+     * Returns finalized translations, in the order of \a messages
+     *
+     * \sa KLazyLocalizedString::toStringList
+     *
+     * \since 6.30
+     */
+    Q_REQUIRED_RESULT static QStringList toStringList(QSpan<const KLocalizedString> messages);
+
     /*!
      * Indicate to look for translation only in given languages.
      *
@@ -524,6 +571,30 @@ public:
      */
     static void addDomainLocaleDir(const QByteArray &domain, const QString &path);
 
+    /*!
+     * Prepare programmable translations ahead of their first use.
+     *
+     * The first translation with a scripted part loads the Transcript
+     * plugin and the scripting modules of the languages in use, which can
+     * stall the thread in the middle of building its user interface.
+     * If any of the languages in use has scripting modules, this function
+     * loads the plugin and locates the modules on a background thread.
+     * Once that is done, the interpreters of the calling thread are set up
+     * and the modules loaded from its event loop, as script engines can be
+     * used only in the thread which created them.
+     *
+     * Call it right after setApplicationDomain and any setLanguages,
+     * from a thread with a running or soon to run event loop.
+     * Within a KLocalizedScope, the languages and domain of the scope
+     * are prepared instead.
+     *
+     * Returns \c true if the preparation was started, \c false if none
+     * of the languages in use has scripting modules
+     *
+     * \since 6.30
+     */
+    static bool warmUpTranscript();
+
     /*!
      * Find a path to the localized file for the given original path.
      *
@@ -562,10 +633,96 @@ private:
     // exported because called from inline KLazyLocalizedString::operator KLocalizedString()
     KLocalizedString(const char *domain, const char *context, const char *text, const char *plural, bool markupAware);
 
+    // In place counterparts of subs and with* methods, for the inline
+    // i18n* calls and KLazyLocalizedString, which build a message from
+    // a temporary and would otherwise copy it for each argument.
+    void substitute(int a, int fieldWidth = 0, int base = 10, QChar fillChar = QLatin1Char(' '));
+    void substitute(uint a, int fieldWidth = 0, int base = 10, QChar fillChar = QLatin1Char(' '));
+    void substitute(long a, int fieldWidth = 0, int base = 10, QChar fillChar = QLatin1Char(' '));
+    void substitute(ulong a, int fieldWidth = 0, int base = 10, QChar fillChar = QLatin1Char(' '));
+    void substitute(qlonglong a, int fieldWidth = 0, int base = 10, QChar fillChar = QLatin1Char(' '));
+    void substitute(qulonglong a, int fieldWidth = 0, int base = 10, QChar fillChar = QLatin1Char(' '));
+    void substitute(double a, int fieldWidth = 0, char format = 'g', int precision = -1, QChar fillChar = QLatin1Char(' '));
+    void substitute(QChar a, int fieldWidth = 0, QChar fillChar = QLatin1Char(' '));
+    void substitute(const QString &a, int fieldWidth = 0, QChar fillChar = QLatin1Char(' '));
+    void substitute(const KLocalizedString &a, int fieldWidth = 0, QChar fillChar = QLatin1Char(' '));
+    void replaceLanguages(const QStringList &languages);
+    void replaceDomain(const char *domain);
+    void replaceFormat(Kuit::VisualFormat format);
+
+    // exported because called from inline KLazyLocalizedString::toStringList()
+    static QStringList toStringList(QSpan<const KLazyLocalizedString> messages, const char *domain);
+
 private:
     // intentionally not a unique_ptr as this file gets included a lot and using a unique_ptr
     // results in too many template instantiations
-    KLocalizedStringPrivate *const d;
+    KLocalizedStringPrivate *d;
+};
+
+namespace KI18nPrivate
+{
+// Substitute arguments into a temporary message without copying it.
+template<typename... Args>
+inline KLocalizedString subs(KLocalizedString &&message, const Args &...args)
+{
+    (message.substitute(args), ...);
+    return std::move(message);
+}
+}
+
+/*!
+ * \class KLocalizedScope
+ * \inmodule KI18n
+ *
+ * \brief Languages and translation domain for the current thread.
+ *
+ * While a KLocalizedScope exists, messages finalized in the thread
+ * which created it are translated into the given languages,
+ * and looked up in the given domain if they do not specify one,
+ * instead of those set by KLocalizedString::setLanguages
+ * and KLocalizedString::setApplicationDomain.
+ * Other threads are not affected.
+ *
+ * This serves for example a server which prepares notifications for
+ * users with different languages in several threads at once,
+ * without changing the global languages or calling
+ * KLocalizedString::withLanguages for every message.
+ *
+ * \code
+ * {
+ *     KLocalizedScope scope(user.languages());
+ *     notification.setText(i18n("Your order has been shipped."));
+ * }
+ * \endcode
+ *
+ * Scopes can be nested, on destruction the previous languages
+ * and domain of the thread are restored. A scope must be destroyed
+ * in the thread which created it.
+ *
+ * \since 6.30
+ */
+class KI18N_EXPORT KLocalizedScope
+{
+public:
+    /*!
+     * Set languages and translation domain for the current thread.
+     *
+     * \a languages list of language codes (by decreasing priority),
+     *                  empty to keep the current languages
+     *
+     * \a domain translation domain, empty to keep the current domain
+     */
+    explicit KLocalizedScope(const QStringList &languages, const QByteArray &domain = QByteArray());
+
+    /*!
+     * Restore the previous languages and translation domain of the thread.
+     */
+    ~KLocalizedScope();
+
+private:
+    Q_DISABLE_COPY(KLocalizedScope)
+
+    KLocalizedScopePrivate *const d;
 };
 
 // Do not document every multi-argument i18n* call separately,
@@ -1209,56 +1366,56 @@ template<typename A1>
 inline QString i18n(const char *text, const A1 &a1)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18n(text).subs(a1).toString();
+    return KI18nPrivate::subs(ki18n(text), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString i18n(const char *text, const A1 &a1, const A2 &a2)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18n(text).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(ki18n(text), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString i18n(const char *text, const A1 &a1, const A2 &a2, const A3 &a3)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18n(text).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(ki18n(text), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString i18n(const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18n(text).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(ki18n(text), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString i18n(const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18n(text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(ki18n(text), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString i18n(const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18n(text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(ki18n(text), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString i18n(const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18n(text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(ki18n(text), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString i18n(const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7, const A8 &a8)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18n(text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(ki18n(text), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString
 i18n(const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7, const A8 &a8, const A9 &a9)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18n(text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(ki18n(text), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<<<< End of basic calls
 
@@ -1271,43 +1428,43 @@ inline QString i18nc(const char *context, const char *text)
 template<typename A1>
 inline QString i18nc(const char *context, const char *text, const A1 &a1)
 {
-    return ki18nc(context, text).subs(a1).toString();
+    return KI18nPrivate::subs(ki18nc(context, text), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString i18nc(const char *context, const char *text, const A1 &a1, const A2 &a2)
 {
-    return ki18nc(context, text).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(ki18nc(context, text), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString i18nc(const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3)
 {
-    return ki18nc(context, text).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(ki18nc(context, text), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString i18nc(const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
-    return ki18nc(context, text).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(ki18nc(context, text), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString i18nc(const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
-    return ki18nc(context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(ki18nc(context, text), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString i18nc(const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
 {
-    return ki18nc(context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(ki18nc(context, text), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString i18nc(const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7)
 {
-    return ki18nc(context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(ki18nc(context, text), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString
 i18nc(const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7, const A8 &a8)
 {
-    return ki18nc(context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(ki18nc(context, text), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString i18nc(const char *context,
@@ -1322,7 +1479,7 @@ inline QString i18nc(const char *context,
                      const A8 &a8,
                      const A9 &a9)
 {
-    return ki18nc(context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(ki18nc(context, text), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<< End of context calls
 
@@ -1331,43 +1488,43 @@ inline QString i18nc(const char *context,
 template<typename A1>
 inline QString i18np(const char *singular, const char *plural, const A1 &a1)
 {
-    return ki18np(singular, plural).subs(a1).toString();
+    return KI18nPrivate::subs(ki18np(singular, plural), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString i18np(const char *singular, const char *plural, const A1 &a1, const A2 &a2)
 {
-    return ki18np(singular, plural).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(ki18np(singular, plural), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString i18np(const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3)
 {
-    return ki18np(singular, plural).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(ki18np(singular, plural), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString i18np(const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
-    return ki18np(singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(ki18np(singular, plural), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString i18np(const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
-    return ki18np(singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(ki18np(singular, plural), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString i18np(const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
 {
-    return ki18np(singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(ki18np(singular, plural), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString i18np(const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7)
 {
-    return ki18np(singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(ki18np(singular, plural), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString
 i18np(const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7, const A8 &a8)
 {
-    return ki18np(singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(ki18np(singular, plural), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString i18np(const char *singular,
@@ -1382,7 +1539,7 @@ inline QString i18np(const char *singular,
                      const A8 &a8,
                      const A9 &a9)
 {
-    return ki18np(singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(ki18np(singular, plural), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<< End of plural calls
 
@@ -1391,33 +1548,33 @@ inline QString i18np(const char *singular,
 template<typename A1>
 inline QString i18ncp(const char *context, const char *singular, const char *plural, const A1 &a1)
 {
-    return ki18ncp(context, singular, plural).subs(a1).toString();
+    return KI18nPrivate::subs(ki18ncp(context, singular, plural), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString i18ncp(const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2)
 {
-    return ki18ncp(context, singular, plural).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(ki18ncp(context, singular, plural), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString i18ncp(const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3)
 {
-    return ki18ncp(context, singular, plural).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(ki18ncp(context, singular, plural), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString i18ncp(const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
-    return ki18ncp(context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(ki18ncp(context, singular, plural), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString i18ncp(const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
-    return ki18ncp(context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(ki18ncp(context, singular, plural), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString
 i18ncp(const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
 {
-    return ki18ncp(context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(ki18ncp(context, singular, plural), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString i18ncp(const char *context,
@@ -1431,7 +1588,7 @@ inline QString i18ncp(const char *context,
                       const A6 &a6,
                       const A7 &a7)
 {
-    return ki18ncp(context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(ki18ncp(context, singular, plural), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString i18ncp(const char *context,
@@ -1446,7 +1603,7 @@ inline QString i18ncp(const char *context,
                       const A7 &a7,
                       const A8 &a8)
 {
-    return ki18ncp(context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(ki18ncp(context, singular, plural), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString i18ncp(const char *context,
@@ -1462,7 +1619,7 @@ inline QString i18ncp(const char *context,
                       const A8 &a8,
                       const A9 &a9)
 {
-    return ki18ncp(context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(ki18ncp(context, singular, plural), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<< End of context-plural calls
 
@@ -1476,50 +1633,50 @@ template<typename A1>
 inline QString i18nd(const char *domain, const char *text, const A1 &a1)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18nd(domain, text).subs(a1).toString();
+    return KI18nPrivate::subs(ki18nd(domain, text), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString i18nd(const char *domain, const char *text, const A1 &a1, const A2 &a2)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18nd(domain, text).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(ki18nd(domain, text), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString i18nd(const char *domain, const char *text, const A1 &a1, const A2 &a2, const A3 &a3)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18nd(domain, text).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(ki18nd(domain, text), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString i18nd(const char *domain, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18nd(domain, text).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(ki18nd(domain, text), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString i18nd(const char *domain, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18nd(domain, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(ki18nd(domain, text), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString i18nd(const char *domain, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18nd(domain, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(ki18nd(domain, text), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString i18nd(const char *domain, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18nd(domain, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(ki18nd(domain, text), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString
 i18nd(const char *domain, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7, const A8 &a8)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18nd(domain, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(ki18nd(domain, text), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString i18nd(const char *domain,
@@ -1535,7 +1692,7 @@ inline QString i18nd(const char *domain,
                      const A9 &a9)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return ki18nd(domain, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(ki18nd(domain, text), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<<<< End of basic calls with domain
 
@@ -1548,33 +1705,33 @@ inline QString i18ndc(const char *domain, const char *context, const char *text)
 template<typename A1>
 inline QString i18ndc(const char *domain, const char *context, const char *text, const A1 &a1)
 {
-    return ki18ndc(domain, context, text).subs(a1).toString();
+    return KI18nPrivate::subs(ki18ndc(domain, context, text), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString i18ndc(const char *domain, const char *context, const char *text, const A1 &a1, const A2 &a2)
 {
-    return ki18ndc(domain, context, text).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(ki18ndc(domain, context, text), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString i18ndc(const char *domain, const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3)
 {
-    return ki18ndc(domain, context, text).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(ki18ndc(domain, context, text), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString i18ndc(const char *domain, const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
-    return ki18ndc(domain, context, text).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(ki18ndc(domain, context, text), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString i18ndc(const char *domain, const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
-    return ki18ndc(domain, context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(ki18ndc(domain, context, text), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString
 i18ndc(const char *domain, const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
 {
-    return ki18ndc(domain, context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(ki18ndc(domain, context, text), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString i18ndc(const char *domain,
@@ -1588,7 +1745,7 @@ inline QString i18ndc(const char *domain,
                       const A6 &a6,
                       const A7 &a7)
 {
-    return ki18ndc(domain, context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(ki18ndc(domain, context, text), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString i18ndc(const char *domain,
@@ -1603,7 +1760,7 @@ inline QString i18ndc(const char *domain,
                       const A7 &a7,
                       const A8 &a8)
 {
-    return ki18ndc(domain, context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(ki18ndc(domain, context, text), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString i18ndc(const char *domain,
@@ -1619,7 +1776,7 @@ inline QString i18ndc(const char *domain,
                       const A8 &a8,
                       const A9 &a9)
 {
-    return ki18ndc(domain, context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(ki18ndc(domain, context, text), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<< End of context calls with domain
 
@@ -1628,33 +1785,33 @@ inline QString i18ndc(const char *domain,
 template<typename A1>
 inline QString i18ndp(const char *domain, const char *singular, const char *plural, const A1 &a1)
 {
-    return ki18ndp(domain, singular, plural).subs(a1).toString();
+    return KI18nPrivate::subs(ki18ndp(domain, singular, plural), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString i18ndp(const char *domain, const char *singular, const char *plural, const A1 &a1, const A2 &a2)
 {
-    return ki18ndp(domain, singular, plural).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(ki18ndp(domain, singular, plural), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString i18ndp(const char *domain, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3)
 {
-    return ki18ndp(domain, singular, plural).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(ki18ndp(domain, singular, plural), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString i18ndp(const char *domain, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
-    return ki18ndp(domain, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(ki18ndp(domain, singular, plural), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString i18ndp(const char *domain, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
-    return ki18ndp(domain, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(ki18ndp(domain, singular, plural), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString
 i18ndp(const char *domain, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
 {
-    return ki18ndp(domain, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(ki18ndp(domain, singular, plural), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString i18ndp(const char *domain,
@@ -1668,7 +1825,7 @@ inline QString i18ndp(const char *domain,
                       const A6 &a6,
                       const A7 &a7)
 {
-    return ki18ndp(domain, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(ki18ndp(domain, singular, plural), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString i18ndp(const char *domain,
@@ -1683,7 +1840,7 @@ inline QString i18ndp(const char *domain,
                       const A7 &a7,
                       const A8 &a8)
 {
-    return ki18ndp(domain, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(ki18ndp(domain, singular, plural), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString i18ndp(const char *domain,
@@ -1699,7 +1856,7 @@ inline QString i18ndp(const char *domain,
                       const A8 &a8,
                       const A9 &a9)
 {
-    return ki18ndp(domain, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(ki18ndp(domain, singular, plural), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<< End of plural calls with domain
 
@@ -1708,29 +1865,29 @@ inline QString i18ndp(const char *domain,
 template<typename A1>
 inline QString i18ndcp(const char *domain, const char *context, const char *singular, const char *plural, const A1 &a1)
 {
-    return ki18ndcp(domain, context, singular, plural).subs(a1).toString();
+    return KI18nPrivate::subs(ki18ndcp(domain, context, singular, plural), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString i18ndcp(const char *domain, const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2)
 {
-    return ki18ndcp(domain, context, singular, plural).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(ki18ndcp(domain, context, singular, plural), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString i18ndcp(const char *domain, const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3)
 {
-    return ki18ndcp(domain, context, singular, plural).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(ki18ndcp(domain, context, singular, plural), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString
 i18ndcp(const char *domain, const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
-    return ki18ndcp(domain, context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(ki18ndcp(domain, context, singular, plural), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString
 i18ndcp(const char *domain, const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
-    return ki18ndcp(domain, context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(ki18ndcp(domain, context, singular, plural), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString i18ndcp(const char *domain,
@@ -1744,7 +1901,7 @@ inline QString i18ndcp(const char *domain,
                        const A5 &a5,
                        const A6 &a6)
 {
-    return ki18ndcp(domain, context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(ki18ndcp(domain, context, singular, plural), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString i18ndcp(const char *domain,
@@ -1759,7 +1916,7 @@ inline QString i18ndcp(const char *domain,
                        const A6 &a6,
                        const A7 &a7)
 {
-    return ki18ndcp(domain, context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(ki18ndcp(domain, context, singular, plural), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString i18ndcp(const char *domain,
@@ -1775,7 +1932,7 @@ inline QString i18ndcp(const char *domain,
                        const A7 &a7,
                        const A8 &a8)
 {
-    return ki18ndcp(domain, context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(ki18ndcp(domain, context, singular, plural), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString i18ndcp(const char *domain,
@@ -1792,7 +1949,7 @@ inline QString i18ndcp(const char *domain,
                        const A8 &a8,
                        const A9 &a9)
 {
-    return ki18ndcp(domain, context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(ki18ndcp(domain, context, singular, plural), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<< End of context-plural calls with domain
 
@@ -1806,56 +1963,56 @@ template<typename A1>
 inline QString xi18n(const char *text, const A1 &a1)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18n(text).subs(a1).toString();
+    return KI18nPrivate::subs(kxi18n(text), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString xi18n(const char *text, const A1 &a1, const A2 &a2)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18n(text).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(kxi18n(text), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString xi18n(const char *text, const A1 &a1, const A2 &a2, const A3 &a3)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18n(text).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(kxi18n(text), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString xi18n(const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18n(text).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(kxi18n(text), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString xi18n(const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18n(text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(kxi18n(text), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString xi18n(const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18n(text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(kxi18n(text), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString xi18n(const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18n(text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(kxi18n(text), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString xi18n(const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7, const A8 &a8)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18n(text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(kxi18n(text), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString
 xi18n(const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7, const A8 &a8, const A9 &a9)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18n(text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(kxi18n(text), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<<<< End of markup-aware basic calls
 
@@ -1868,43 +2025,43 @@ inline QString xi18nc(const char *context, const char *text)
 template<typename A1>
 inline QString xi18nc(const char *context, const char *text, const A1 &a1)
 {
-    return kxi18nc(context, text).subs(a1).toString();
+    return KI18nPrivate::subs(kxi18nc(context, text), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString xi18nc(const char *context, const char *text, const A1 &a1, const A2 &a2)
 {
-    return kxi18nc(context, text).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(kxi18nc(context, text), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString xi18nc(const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3)
 {
-    return kxi18nc(context, text).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(kxi18nc(context, text), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString xi18nc(const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
-    return kxi18nc(context, text).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(kxi18nc(context, text), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString xi18nc(const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
-    return kxi18nc(context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(kxi18nc(context, text), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString xi18nc(const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
 {
-    return kxi18nc(context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(kxi18nc(context, text), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString xi18nc(const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7)
 {
-    return kxi18nc(context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(kxi18nc(context, text), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString
 xi18nc(const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7, const A8 &a8)
 {
-    return kxi18nc(context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(kxi18nc(context, text), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString xi18nc(const char *context,
@@ -1919,7 +2076,7 @@ inline QString xi18nc(const char *context,
                       const A8 &a8,
                       const A9 &a9)
 {
-    return kxi18nc(context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(kxi18nc(context, text), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<< End of markup-aware context calls
 
@@ -1928,44 +2085,44 @@ inline QString xi18nc(const char *context,
 template<typename A1>
 inline QString xi18np(const char *singular, const char *plural, const A1 &a1)
 {
-    return kxi18np(singular, plural).subs(a1).toString();
+    return KI18nPrivate::subs(kxi18np(singular, plural), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString xi18np(const char *singular, const char *plural, const A1 &a1, const A2 &a2)
 {
-    return kxi18np(singular, plural).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(kxi18np(singular, plural), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString xi18np(const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3)
 {
-    return kxi18np(singular, plural).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(kxi18np(singular, plural), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString xi18np(const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
-    return kxi18np(singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(kxi18np(singular, plural), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString xi18np(const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
-    return kxi18np(singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(kxi18np(singular, plural), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString xi18np(const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
 {
-    return kxi18np(singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(kxi18np(singular, plural), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString
 xi18np(const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7)
 {
-    return kxi18np(singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(kxi18np(singular, plural), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString
 xi18np(const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7, const A8 &a8)
 {
-    return kxi18np(singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(kxi18np(singular, plural), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString xi18np(const char *singular,
@@ -1980,7 +2137,7 @@ inline QString xi18np(const char *singular,
                       const A8 &a8,
                       const A9 &a9)
 {
-    return kxi18np(singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(kxi18np(singular, plural), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<< End of markup-aware plural calls
 
@@ -1989,33 +2146,33 @@ inline QString xi18np(const char *singular,
 template<typename A1>
 inline QString xi18ncp(const char *context, const char *singular, const char *plural, const A1 &a1)
 {
-    return kxi18ncp(context, singular, plural).subs(a1).toString();
+    return KI18nPrivate::subs(kxi18ncp(context, singular, plural), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString xi18ncp(const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2)
 {
-    return kxi18ncp(context, singular, plural).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(kxi18ncp(context, singular, plural), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString xi18ncp(const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3)
 {
-    return kxi18ncp(context, singular, plural).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(kxi18ncp(context, singular, plural), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString xi18ncp(const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
-    return kxi18ncp(context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(kxi18ncp(context, singular, plural), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString xi18ncp(const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
-    return kxi18ncp(context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(kxi18ncp(context, singular, plural), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString
 xi18ncp(const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
 {
-    return kxi18ncp(context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(kxi18ncp(context, singular, plural), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString xi18ncp(const char *context,
@@ -2029,7 +2186,7 @@ inline QString xi18ncp(const char *context,
                        const A6 &a6,
                        const A7 &a7)
 {
-    return kxi18ncp(context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(kxi18ncp(context, singular, plural), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString xi18ncp(const char *context,
@@ -2044,7 +2201,7 @@ inline QString xi18ncp(const char *context,
                        const A7 &a7,
                        const A8 &a8)
 {
-    return kxi18ncp(context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(kxi18ncp(context, singular, plural), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString xi18ncp(const char *context,
@@ -2060,7 +2217,7 @@ inline QString xi18ncp(const char *context,
                        const A8 &a8,
                        const A9 &a9)
 {
-    return kxi18ncp(context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(kxi18ncp(context, singular, plural), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<< End of markup-aware context-plural calls
 
@@ -2074,50 +2231,50 @@ template<typename A1>
 inline QString xi18nd(const char *domain, const char *text, const A1 &a1)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18nd(domain, text).subs(a1).toString();
+    return KI18nPrivate::subs(kxi18nd(domain, text), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString xi18nd(const char *domain, const char *text, const A1 &a1, const A2 &a2)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18nd(domain, text).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(kxi18nd(domain, text), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString xi18nd(const char *domain, const char *text, const A1 &a1, const A2 &a2, const A3 &a3)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18nd(domain, text).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(kxi18nd(domain, text), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString xi18nd(const char *domain, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18nd(domain, text).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(kxi18nd(domain, text), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString xi18nd(const char *domain, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18nd(domain, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(kxi18nd(domain, text), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString xi18nd(const char *domain, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18nd(domain, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(kxi18nd(domain, text), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString xi18nd(const char *domain, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18nd(domain, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(kxi18nd(domain, text), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString
 xi18nd(const char *domain, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7, const A8 &a8)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18nd(domain, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(kxi18nd(domain, text), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString xi18nd(const char *domain,
@@ -2133,7 +2290,7 @@ inline QString xi18nd(const char *domain,
                       const A9 &a9)
 {
     STATIC_ASSERT_NOT_LITERAL_STRING(A1)
-    return kxi18nd(domain, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(kxi18nd(domain, text), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<<<< End of markup-aware basic calls with domain
 
@@ -2146,33 +2303,33 @@ inline QString xi18ndc(const char *domain, const char *context, const char *text
 template<typename A1>
 inline QString xi18ndc(const char *domain, const char *context, const char *text, const A1 &a1)
 {
-    return kxi18ndc(domain, context, text).subs(a1).toString();
+    return KI18nPrivate::subs(kxi18ndc(domain, context, text), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString xi18ndc(const char *domain, const char *context, const char *text, const A1 &a1, const A2 &a2)
 {
-    return kxi18ndc(domain, context, text).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(kxi18ndc(domain, context, text), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString xi18ndc(const char *domain, const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3)
 {
-    return kxi18ndc(domain, context, text).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(kxi18ndc(domain, context, text), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString xi18ndc(const char *domain, const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
-    return kxi18ndc(domain, context, text).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(kxi18ndc(domain, context, text), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString xi18ndc(const char *domain, const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
-    return kxi18ndc(domain, context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(kxi18ndc(domain, context, text), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString
 xi18ndc(const char *domain, const char *context, const char *text, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
 {
-    return kxi18ndc(domain, context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(kxi18ndc(domain, context, text), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString xi18ndc(const char *domain,
@@ -2186,7 +2343,7 @@ inline QString xi18ndc(const char *domain,
                        const A6 &a6,
                        const A7 &a7)
 {
-    return kxi18ndc(domain, context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(kxi18ndc(domain, context, text), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString xi18ndc(const char *domain,
@@ -2201,7 +2358,7 @@ inline QString xi18ndc(const char *domain,
                        const A7 &a7,
                        const A8 &a8)
 {
-    return kxi18ndc(domain, context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(kxi18ndc(domain, context, text), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString xi18ndc(const char *domain,
@@ -2217,7 +2374,7 @@ inline QString xi18ndc(const char *domain,
                        const A8 &a8,
                        const A9 &a9)
 {
-    return kxi18ndc(domain, context, text).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(kxi18ndc(domain, context, text), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<< End of markup-aware context calls with domain
 
@@ -2226,33 +2383,33 @@ inline QString xi18ndc(const char *domain,
 template<typename A1>
 inline QString xi18ndp(const char *domain, const char *singular, const char *plural, const A1 &a1)
 {
-    return kxi18ndp(domain, singular, plural).subs(a1).toString();
+    return KI18nPrivate::subs(kxi18ndp(domain, singular, plural), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString xi18ndp(const char *domain, const char *singular, const char *plural, const A1 &a1, const A2 &a2)
 {
-    return kxi18ndp(domain, singular, plural).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(kxi18ndp(domain, singular, plural), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString xi18ndp(const char *domain, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3)
 {
-    return kxi18ndp(domain, singular, plural).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(kxi18ndp(domain, singular, plural), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString xi18ndp(const char *domain, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
-    return kxi18ndp(domain, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(kxi18ndp(domain, singular, plural), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString xi18ndp(const char *domain, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
 {
-    return kxi18ndp(domain, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(kxi18ndp(domain, singular, plural), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString
 xi18ndp(const char *domain, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
 {
-    return kxi18ndp(domain, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(kxi18ndp(domain, singular, plural), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString xi18ndp(const char *domain,
@@ -2266,7 +2423,7 @@ inline QString xi18ndp(const char *domain,
                        const A6 &a6,
                        const A7 &a7)
 {
-    return kxi18ndp(domain, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(kxi18ndp(domain, singular, plural), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString xi18ndp(const char *domain,
@@ -2281,7 +2438,7 @@ inline QString xi18ndp(const char *domain,
                        const A7 &a7,
                        const A8 &a8)
 {
-    return kxi18ndp(domain, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(kxi18ndp(domain, singular, plural), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString xi18ndp(const char *domain,
@@ -2297,7 +2454,7 @@ inline QString xi18ndp(const char *domain,
                        const A8 &a8,
                        const A9 &a9)
 {
-    return kxi18ndp(domain, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(kxi18ndp(domain, singular, plural), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<< End of markup-aware plural calls with domain
 
@@ -2306,23 +2463,23 @@ inline QString xi18ndp(const char *domain,
 template<typename A1>
 inline QString xi18ndcp(const char *domain, const char *context, const char *singular, const char *plural, const A1 &a1)
 {
-    return kxi18ndcp(domain, context, singular, plural).subs(a1).toString();
+    return KI18nPrivate::subs(kxi18ndcp(domain, context, singular, plural), a1).toString();
 }
 template<typename A1, typename A2>
 inline QString xi18ndcp(const char *domain, const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2)
 {
-    return kxi18ndcp(domain, context, singular, plural).subs(a1).subs(a2).toString();
+    return KI18nPrivate::subs(kxi18ndcp(domain, context, singular, plural), a1, a2).toString();
 }
 template<typename A1, typename A2, typename A3>
 inline QString xi18ndcp(const char *domain, const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3)
 {
-    return kxi18ndcp(domain, context, singular, plural).subs(a1).subs(a2).subs(a3).toString();
+    return KI18nPrivate::subs(kxi18ndcp(domain, context, singular, plural), a1, a2, a3).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4>
 inline QString
 xi18ndcp(const char *domain, const char *context, const char *singular, const char *plural, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
 {
-    return kxi18ndcp(domain, context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).toString();
+    return KI18nPrivate::subs(kxi18ndcp(domain, context, singular, plural), a1, a2, a3, a4).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5>
 inline QString xi18ndcp(const char *domain,
@@ -2335,7 +2492,7 @@ inline QString xi18ndcp(const char *domain,
                         const A4 &a4,
                         const A5 &a5)
 {
-    return kxi18ndcp(domain, context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).toString();
+    return KI18nPrivate::subs(kxi18ndcp(domain, context, singular, plural), a1, a2, a3, a4, a5).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
 inline QString xi18ndcp(const char *domain,
@@ -2349,7 +2506,7 @@ inline QString xi18ndcp(const char *domain,
                         const A5 &a5,
                         const A6 &a6)
 {
-    return kxi18ndcp(domain, context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).toString();
+    return KI18nPrivate::subs(kxi18ndcp(domain, context, singular, plural), a1, a2, a3, a4, a5, a6).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
 inline QString xi18ndcp(const char *domain,
@@ -2364,7 +2521,7 @@ inline QString xi18ndcp(const char *domain,
                         const A6 &a6,
                         const A7 &a7)
 {
-    return kxi18ndcp(domain, context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).toString();
+    return KI18nPrivate::subs(kxi18ndcp(domain, context, singular, plural), a1, a2, a3, a4, a5, a6, a7).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
 inline QString xi18ndcp(const char *domain,
@@ -2380,7 +2537,7 @@ inline QString xi18ndcp(const char *domain,
                         const A7 &a7,
                         const A8 &a8)
 {
-    return kxi18ndcp(domain, context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).toString();
+    return KI18nPrivate::subs(kxi18ndcp(domain, context, singular, plural), a1, a2, a3, a4, a5, a6, a7, a8).toString();
 }
 template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
 inline QString xi18ndcp(const char *domain,
@@ -2397,7 +2554,7 @@ inline QString xi18ndcp(const char *domain,
                         const A8 &a8,
                         const A9 &a9)
 {
-    return kxi18ndcp(domain, context, singular, plural).subs(a1).subs(a2).subs(a3).subs(a4).subs(a5).subs(a6).subs(a7).subs(a8).subs(a9).toString();
+    return KI18nPrivate::subs(kxi18ndcp(domain, context, singular, plural), a1, a2, a3, a4, a5, a6, a7, a8, a9).toString();
 }
 // <<<<< End of markup-aware context-plural calls with domain
 
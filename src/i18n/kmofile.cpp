@@ -0,0 +1,674 @@
+/*  This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kmofile_p.h"
+
+#include "ki18n_logging.h"
+
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// Layout of the .mo file header, see "The Format of GNU MO Files"
+// in the GNU Gettext manual.
+static constexpr quint32 s_moMagic = 0x950412de;
+static constexpr qsizetype s_moHeaderSize = 28;
+static constexpr char s_contextGlue = '\004';
+
+// Limit on nesting of Plural-Forms expressions, against corrupt catalogs.
+// Real expressions are nested a dozen levels or so.
+static constexpr int s_maxPluralDepth = 64;
+
+/*!
+ * \internal
+ *
+ * Compiled Plural-Forms expression.
+ *
+ * The expression is C-like, built of the variable n, unsigned
+ * integer constants, parenthesis, and the operators
+ * ! * / % + - < > <= >= == != && || ?:
+ * with the same precedence and associativity as in C.
+ */
+class KMoPluralExpression
+{
+public:
+    static std::unique_ptr<KMoPluralExpression> parse(QByteArrayView source);
+
+    quint64 evaluate(quint64 n) const
+    {
+        return evaluate(m_root, n);
+    }
+
+private:
+    enum Op {
+        Variable,
+        Constant,
+        Not,
+        Multiply,
+        Divide,
+        Modulo,
+        Plus,
+        Minus,
+        Less,
+        Greater,
+        LessOrEqual,
+        GreaterOrEqual,
+        Equal,
+        NotEqual,
+        And,
+        Or,
+        Conditional,
+    };
+
+    struct Node {
+        Op op;
+        quint64 value;
+        int operands[3];
+        // Height of the subtree, which bounds the recursion of evaluate().
+        int depth;
+    };
+
+    int addNode(Op op, quint64 value = 0, int a = -1, int b = -1, int c = -1)
+    {
+        int depth = 0;
+        for (int operand : {a, b, c}) {
+            if (operand >= 0) {
+                depth = std::max(depth, m_nodes[operand].depth);
+            }
+        }
+        if (++depth > s_maxPluralDepth) {
+            return -1;
+        }
+        m_nodes.push_back({op, value, {a, b, c}, depth});
+        return int(m_nodes.size()) - 1;
+    }
+
+    quint64 evaluate(int node, quint64 n) const;
+
+    // Recursive descent parser, each level returns node index or -1 on error.
+    void skipSpace();
+    bool consume(const char *token);
+    int parseConditional();
+    int parseOr();
+    int parseAnd();
+    int parseEquality();
+    int parseRelational();
+    int parseAdditive();
+    int parseMultiplicative();
+    int parseUnary();
+    int parsePrimary();
+
+    std::vector<Node> m_nodes;
+    int m_root = -1;
+
+    // Parsing state.
+    QByteArrayView m_source;
+    qsizetype m_pos = 0;
+    int m_depth = 0;
+};
+
+std::unique_ptr<KMoPluralExpression> KMoPluralExpression::parse(QByteArrayView source)
+{
+    auto expr = std::make_unique<KMoPluralExpression>();
+    expr->m_source = source;
+    expr->m_root = expr->parseConditional();
+    expr->skipSpace();
+    if (expr->m_root < 0 || expr->m_pos != source.size()) {
+        return nullptr;
+    }
+    expr->m_source = QByteArrayView();
+    return expr;
+}
+
+quint64 KMoPluralExpression::evaluate(int index, quint64 n) const
+{
+    const Node &node = m_nodes[index];
+    const int *x = node.operands;
+    switch (node.op) {
+    case Variable:
+        return n;
+    case Constant:
+        return node.value;
+    case Not:
+        return !evaluate(x[0], n);
+    case Multiply:
+        return evaluate(x[0], n) * evaluate(x[1], n);
+    case Divide:
+    case Modulo: {
+        const quint64 lhs = evaluate(x[0], n);
+        const quint64 rhs = evaluate(x[1], n);
+        // Gettext would raise SIGFPE here, be more forgiving.
+        if (rhs == 0) {
+            return 0;
+        }
+        return node.op == Divide ? lhs / rhs : lhs % rhs;
+    }
+    case Plus:
+        return evaluate(x[0], n) + evaluate(x[1], n);
+    case Minus:
+        return evaluate(x[0], n) - evaluate(x[1], n);
+    case Less:
+        return evaluate(x[0], n) < evaluate(x[1], n);
+    case Greater:
+        return evaluate(x[0], n) > evaluate(x[1], n);
+    case LessOrEqual:
+        return evaluate(x[0], n) <= evaluate(x[1], n);
+    case GreaterOrEqual:
+        return evaluate(x[0], n) >= evaluate(x[1], n);
+    case Equal:
+        return evaluate(x[0], n) == evaluate(x[1], n);
+    case NotEqual:
+        return evaluate(x[0], n) != evaluate(x[1], n);
+    case And:
+        return evaluate(x[0], n) && evaluate(x[1], n);
+    case Or:
+        return evaluate(x[0], n) || evaluate(x[1], n);
+    case Conditional:
+        return evaluate(x[0], n) ? evaluate(x[1], n) : evaluate(x[2], n);
+    }
+    return 0;
+}
+
+void KMoPluralExpression::skipSpace()
+{
+    while (m_pos < m_source.size() && (m_source[m_pos] == ' ' || m_source[m_pos] == '\t')) {
+        ++m_pos;
+    }
+}
+
+bool KMoPluralExpression::consume(const char *token)
+{
+    skipSpace();
+    const qsizetype len = qstrlen(token);
+    if (m_source.mid(m_pos, len) != QByteArrayView(token, len)) {
+        return false;
+    }
+    // Do not split two-character operators, e.g. take "<" from "<=".
+    if (len == 1 && m_pos + 1 < m_source.size()) {
+        const char next = m_source[m_pos + 1];
+        if ((next == '=' && std::strchr("<>=!", token[0])) || (next == token[0] && std::strchr("&|", token[0]))) {
+            return false;
+        }
+    }
+    m_pos += len;
+    return true;
+}
+
+int KMoPluralExpression::parseConditional()
+{
+    // Guard against pathologically nested expressions.
+    if (++m_depth > s_maxPluralDepth) {
+        return -1;
+    }
+    int node = parseOr();
+    if (node >= 0 && consume("?")) {
+        const int a = parseConditional();
+        if (a < 0 || !consume(":")) {
+            return -1;
+        }
+        const int b = parseConditional();
+        if (b < 0) {
+            return -1;
+        }
+        node = addNode(Conditional, 0, node, a, b);
+    }
+    --m_depth;
+    return node;
+}
+
+int KMoPluralExpression::parseOr()
+{
+    int node = parseAnd();
+    while (node >= 0 && consume("||")) {
+        const int rhs = parseAnd();
+        node = rhs < 0 ? -1 : addNode(Or, 0, node, rhs);
+    }
+    return node;
+}
+
+int KMoPluralExpression::parseAnd()
+{
+    int node = parseEquality();
+    while (node >= 0 && consume("&&")) {
+        const int rhs = parseEquality();
+        node = rhs < 0 ? -1 : addNode(And, 0, node, rhs);
+    }
+    return node;
+}
+
+int KMoPluralExpression::parseEquality()
+{
+    int node = parseRelational();
+    while (node >= 0) {
+        Op op;
+        if (consume("==")) {
+            op = Equal;
+        } else if (consume("!=")) {
+            op = NotEqual;
+        } else {
+            break;
+        }
+        const int rhs = parseRelational();
+        node = rhs < 0 ? -1 : addNode(op, 0, node, rhs);
+    }
+    return node;
+}
+
+int KMoPluralExpression::parseRelational()
+{
+    int node = parseAdditive();
+    while (node >= 0) {
+        Op op;
+        if (consume("<=")) {
+            op = LessOrEqual;
+        } else if (consume(">=")) {
+            op = GreaterOrEqual;
+        } else if (consume("<")) {
+            op = Less;
+        } else if (consume(">")) {
+            op = Greater;
+        } else {
+            break;
+        }
+        const int rhs = parseAdditive();
+        node = rhs < 0 ? -1 : addNode(op, 0, node, rhs);
+    }
+    return node;
+}
+
+int KMoPluralExpression::parseAdditive()
+{
+    int node = parseMultiplicative();
+    while (node >= 0) {
+        Op op;
+        if (consume("+")) {
+            op = Plus;
+        } else if (consume("-")) {
+            op = Minus;
+        } else {
+            break;
+        }
+        const int rhs = parseMultiplicative();
+        node = rhs < 0 ? -1 : addNode(op, 0, node, rhs);
+    }
+    return node;
+}
+
+int KMoPluralExpression::parseMultiplicative()
+{
+    int node = parseUnary();
+    while (node >= 0) {
+        Op op;
+        if (consume("*")) {
+            op = Multiply;
+        } else if (consume("/")) {
+            op = Divide;
+        } else if (consume("%")) {
+            op = Modulo;
+        } else {
+            break;
+        }
+        const int rhs = parseUnary();
+        node = rhs < 0 ? -1 : addNode(op, 0, node, rhs);
+    }
+    return node;
+}
+
+int KMoPluralExpression::parseUnary()
+{
+    if (consume("!")) {
+        if (++m_depth > s_maxPluralDepth) {
+            return -1;
+        }
+        const int operand = parseUnary();
+        --m_depth;
+        return operand < 0 ? -1 : addNode(Not, 0, operand);
+    }
+    return parsePrimary();
+}
+
+int KMoPluralExpression::parsePrimary()
+{
+    skipSpace();
+    if (m_pos == m_source.size()) {
+        return -1;
+    }
+    const char c = m_source[m_pos];
+    if (c == 'n') {
+        ++m_pos;
+        return addNode(Variable);
+    }
+    if (c >= '0' && c <= '9') {
+        quint64 value = 0;
+        while (m_pos < m_source.size() && m_source[m_pos] >= '0' && m_source[m_pos] <= '9') {
+            value = 10 * value + (m_source[m_pos] - '0');
+            ++m_pos;
+        }
+        return addNode(Constant, value);
+    }
+    if (consume("(")) {
+        const int node = parseConditional();
+        if (node < 0 || !consume(")")) {
+            return -1;
+        }
+        return node;
+    }
+    return -1;
+}
+
+// Lookups in the catalog hash table work only with the exact hash of msgfmt,
+// including for keys whose hash carries past 32 bits, like this one.
+static_assert([] {
+    KMoKeyHasher hasher;
+    hasher.add("\xe7\xa3\xc4\xb0\xf4\xa4\xdf\xf9\xff");
+    return hasher.table();
+}() == 0x8f);
+
+KMoKeyHash::KMoKeyHash(const QByteArray &msgctxt, const QByteArray &msgid)
+{
+    KMoKeyHasher hasher;
+    if (!msgctxt.isNull()) {
+        hasher.add(msgctxt);
+        hasher.add(s_contextGlue);
+    }
+    hasher.add(msgid);
+    *this = KMoKeyHash(hasher);
+}
+
+KMoKeyHash::KMoKeyHash(QByteArrayView key)
+{
+    KMoKeyHasher hasher;
+    hasher.add(key);
+    *this = KMoKeyHash(hasher);
+}
+
+// Parameters of the negative lookup filter, about 1% false positives.
+static constexpr int s_filterBitsPerKey = 10;
+static constexpr int s_filterProbes = 7;
+
+// Check whether the original string from the catalog equals the key.
+// Originals of plural messages continue after the msgid with a null
+// byte and the plural text, which does not take part in the comparison.
+static bool keyMatches(QByteArrayView original, const QByteArray &msgctxt, const QByteArray &msgid)
+{
+    qsizetype keyLength = msgid.size();
+    if (!msgctxt.isNull()) {
+        keyLength += msgctxt.size() + 1;
+    }
+    if (original.size() < keyLength || (original.size() > keyLength && original[keyLength] != '\0')) {
+        return false;
+    }
+    if (!msgctxt.isNull()) {
+        if (!original.startsWith(msgctxt) || original[msgctxt.size()] != s_contextGlue) {
+            return false;
+        }
+        original = original.sliced(msgctxt.size() + 1);
+    }
+    return std::memcmp(original.data(), msgid.constData(), msgid.size()) == 0;
+}
+
+KMoFile::KMoFile(const uchar *data, qsizetype size)
+    : m_data(data)
+    , m_size(size)
+{
+    if (!m_data || m_size < s_moHeaderSize) {
+        return;
+    }
+
+    const quint32 magic = qFromUnaligned<quint32>(m_data);
+    if (magic == qbswap(s_moMagic)) {
+        m_swapped = true;
+    } else if (magic != s_moMagic) {
+        return;
+    }
+
+    // Only the major revision matters, minor ones are backward compatible.
+    const quint32 revision = readWord(4);
+    if ((revision >> 16) > 1) {
+        return;
+    }
+
+    m_count = readWord(8);
+    m_originals = readWord(12);
+    m_translations = readWord(16);
+    m_hashSize = readWord(20);
+    m_hashTable = readWord(24);
+
+    // Tables of string descriptors (length, offset) must be in range,
+    // individual strings are checked when accessed.
+    const quint64 tableSize = quint64(m_count) * 8;
+    if (quint64(m_originals) + tableSize > quint64(m_size) || quint64(m_translations) + tableSize > quint64(m_size)) {
+        return;
+    }
+    // Gettext does not use hash tables of size 2 or less either.
+    if (m_hashSize <= 2 || quint64(m_hashTable) + quint64(m_hashSize) * 4 > quint64(m_size)) {
+        m_hashSize = 0;
+    }
+
+    m_valid = true;
+    parseHeader();
+    buildFilter();
+}
+
+KMoFile::~KMoFile() = default;
+
+bool KMoFile::isValid() const
+{
+    return m_valid;
+}
+
+QByteArray KMoFile::charset() const
+{
+    return m_charset;
+}
+
+quint32 KMoFile::readWord(qsizetype offset) const
+{
+    const quint32 word = qFromUnaligned<quint32>(m_data + offset);
+    return m_swapped ? qbswap(word) : word;
+}
+
+QByteArrayView KMoFile::stringAt(quint32 tableOffset, quint32 index) const
+{
+    const qsizetype descriptor = qsizetype(tableOffset) + qsizetype(index) * 8;
+    const quint32 length = readWord(descriptor);
+    const quint32 offset = readWord(descriptor + 4);
+    // Strings are followed by a terminating null byte.
+    if (quint64(offset) + quint64(length) >= quint64(m_size)) {
+        return QByteArrayView();
+    }
+    return QByteArrayView(m_data + offset, length);
+}
+
+void KMoFile::buildFilter()
+{
+    // Use a power of two number of bits, to turn modulo into masking.
+    qsizetype bits = 64;
+    while (bits < qsizetype(m_count) * s_filterBitsPerKey) {
+        bits *= 2;
+    }
+    m_filter.fill(0, bits / 64);
+
+    for (quint32 i = 0; i < m_count; ++i) {
+        QByteArrayView original = stringAt(m_originals, i);
+        // For plural messages, only the part before the plural text is the key.
+        original = original.first(qstrnlen(original.data(), original.size()));
+        const KMoKeyHash hash(original);
+        quint32 h = quint32(hash.filter);
+        const quint32 delta = quint32(hash.filter >> 32) | 1;
+        for (int probe = 0; probe < s_filterProbes; ++probe) {
+            const quint32 bit = h & (bits - 1);
+            m_filter[bit / 64] |= quint64(1) << (bit % 64);
+            h += delta;
+        }
+    }
+}
+
+bool KMoFile::filterMayContain(const KMoKeyHash &hash) const
+{
+    const qsizetype bits = m_filter.size() * 64;
+    quint32 h = quint32(hash.filter);
+    const quint32 delta = quint32(hash.filter >> 32) | 1;
+    for (int probe = 0; probe < s_filterProbes; ++probe) {
+        const quint32 bit = h & (bits - 1);
+        if (!(m_filter.at(bit / 64) & (quint64(1) << (bit % 64)))) {
+            return false;
+        }
+        h += delta;
+    }
+    return true;
+}
+
+QByteArrayView KMoFile::lookup(const QByteArray &msgctxt, const QByteArray &msgid, const KMoKeyHash &hash) const
+{
+    if (!m_valid) {
+        return QByteArrayView();
+    }
+
+    // Most lookups in fallback languages are of messages the catalog
+    // does not have, reject those before probing the catalog data.
+    if (!m_filter.isEmpty() && !filterMayContain(hash)) {
+        return QByteArrayView();
+    }
+
+    if (m_hashSize > 0) {
+        const quint32 hval = hash.table;
+        quint32 idx = hval % m_hashSize;
+        const quint32 incr = 1 + (hval % (m_hashSize - 2));
+        // Open addressing with double hashing, the table is never full.
+        for (quint32 probes = 0; probes < m_hashSize; ++probes) {
+            const quint32 entry = readWord(qsizetype(m_hashTable) + qsizetype(idx) * 4);
+            if (entry == 0) {
+                return QByteArrayView();
+            }
+            // Entries beyond the string count refer to system dependent
+            // strings, which are never produced for KDE catalogs.
+            const quint32 index = entry - 1;
+            if (index < m_count && keyMatches(stringAt(m_originals, index), msgctxt, msgid)) {
+                return stringAt(m_translations, index);
+            }
+            if (idx >= m_hashSize - incr) {
+                idx -= m_hashSize - incr;
+            } else {
+                idx += incr;
+            }
+        }
+        return QByteArrayView();
+    }
+
+    // No hash table, the originals are sorted, so do a binary search.
+    QByteArray key;
+    if (!msgctxt.isNull()) {
+        key = msgctxt + s_contextGlue + msgid;
+    } else {
+        key = msgid;
+    }
+    quint32 bottom = 0;
+    quint32 top = m_count;
+    while (bottom < top) {
+        const quint32 middle = bottom + (top - bottom) / 2;
+        QByteArrayView original = stringAt(m_originals, middle);
+        original = original.first(qstrnlen(original.data(), original.size()));
+        const int cmp = QByteArrayView(key).compare(original);
+        if (cmp < 0) {
+            top = middle;
+        } else if (cmp > 0) {
+            bottom = middle + 1;
+        } else {
+            return stringAt(m_translations, middle);
+        }
+    }
+    return QByteArrayView();
+}
+
+void KMoFile::parseHeader()
+{
+    const QByteArray empty("");
+    const QByteArrayView header = lookup(QByteArray(), empty, KMoKeyHash(QByteArray(), empty));
+
+    auto fieldValue = [header](QByteArrayView field) {
+        const qsizetype start = header.indexOf(field);
+        if (start < 0) {
+            return QByteArrayView();
+        }
+        QByteArrayView value = header.sliced(start + field.size());
+        const qsizetype end = value.indexOf('\n');
+        return end < 0 ? value : value.first(end);
+    };
+
+    const QByteArrayView contentType = fieldValue("Content-Type:");
+    const qsizetype charsetPos = contentType.indexOf("charset=");
+    if (charsetPos >= 0) {
+        m_charset = contentType.sliced(charsetPos + 8).trimmed().toByteArray();
+    }
+
+    const QByteArrayView pluralForms = fieldValue("Plural-Forms:");
+    const qsizetype npluralsPos = pluralForms.indexOf("nplurals=");
+    const qsizetype pluralPos = pluralForms.indexOf("plural=", npluralsPos < 0 ? 0 : npluralsPos + 9);
+    if (npluralsPos >= 0 && pluralPos >= 0) {
+        QByteArrayView count = pluralForms.sliced(npluralsPos + 9);
+        count = count.first(count.indexOf(';') < 0 ? count.size() : count.indexOf(';'));
+        bool ok = false;
+        const unsigned long pluralCount = count.trimmed().toULong(&ok);
+
+        QByteArrayView expression = pluralForms.sliced(pluralPos + 7);
+        const qsizetype end = expression.indexOf(';');
+        if (end >= 0) {
+            expression = expression.first(end);
+        }
+        auto plural = KMoPluralExpression::parse(expression.trimmed());
+
+        if (ok && pluralCount > 0 && plural) {
+            m_pluralCount = pluralCount;
+            m_plural = std::move(plural);
+        } else {
+            qCWarning(KI18N) << "Invalid Plural-Forms header in catalog:" << pluralForms.toByteArray();
+        }
+    }
+}
+
+QByteArrayView KMoFile::translate(const QByteArray &msgctxt, const QByteArray &msgid, const KMoKeyHash &hash) const
+{
+    // Of a plural message, give the first form like Gettext does.
+    const QByteArrayView translation = lookup(msgctxt, msgid, hash);
+    const qsizetype end = translation.indexOf('\0');
+    return end < 0 ? translation : translation.first(end);
+}
+
+QByteArrayView KMoFile::translate(const QByteArray &msgctxt, const QByteArray &msgid, const KMoKeyHash &hash, qulonglong n) const
+{
+    const QByteArrayView translation = lookup(msgctxt, msgid, hash);
+    if (translation.isEmpty()) {
+        return translation;
+    }
+
+    // Plural translations are stored one after another, separated by null bytes.
+    qsizetype start = 0;
+    for (quint64 form = pluralForm(n); form > 0; --form) {
+        const qsizetype end = translation.indexOf('\0', start);
+        if (end < 0) {
+            return QByteArrayView();
+        }
+        start = end + 1;
+    }
+    QByteArrayView text = translation.sliced(start);
+    const qsizetype end = text.indexOf('\0');
+    return end < 0 ? text : text.first(end);
+}
+
+QByteArrayView KMoFile::translatePluralForms(const QByteArray &msgctxt, const QByteArray &msgid, const KMoKeyHash &hash) const
+{
+    return lookup(msgctxt, msgid, hash);
+}
+
+quint64 KMoFile::pluralForm(qulonglong n) const
+{
+    // Without a usable Plural-Forms header, use Germanic plural like Gettext.
+    const quint64 form = m_plural ? m_plural->evaluate(n) : quint64(n != 1);
+    return form < m_pluralCount ? form : 0;
+}
@@ -0,0 +1,252 @@
+/*  This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KMOFILE_P_H
+#define KMOFILE_P_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QList>
+
+#include <ki18n_export.h>
+
+#include <memory>
+
+class KMoPluralExpression;
+
+/*!
+ * \internal
+ *
+ * Computes the hash values of a message key byte by byte.
+ *
+ * All of it is constexpr, so that the hashing can be checked
+ * at compile time against known values.
+ */
+class KMoKeyHasher
+{
+public:
+    constexpr void add(char ch)
+    {
+        const quint64 c = static_cast<unsigned char>(ch);
+        // The hash used by msgfmt for the catalog hash table, computed
+        // in a 64-bit word of which only the low 32 bits are used,
+        // so that bits carried out of them must not be folded back in.
+        m_table = (m_table << 4) + c;
+        const quint64 g = m_table & (quint64(0xf) << 28);
+        if (g != 0) {
+            m_table ^= g >> 24;
+            m_table ^= g;
+        }
+        // 64-bit FNV-1a for the negative lookup filter.
+        m_filter = (m_filter ^ c) * Q_UINT64_C(0x100000001b3);
+    }
+
+    constexpr void add(QByteArrayView bytes)
+    {
+        for (char ch : bytes) {
+            add(ch);
+        }
+    }
+
+    constexpr quint32 table() const
+    {
+        return static_cast<quint32>(m_table);
+    }
+
+    constexpr quint64 filter() const
+    {
+        // Mix the bits, FNV-1a alone spreads short keys poorly.
+        quint64 f = m_filter;
+        f ^= f >> 33;
+        f *= Q_UINT64_C(0xff51afd7ed558ccd);
+        f ^= f >> 33;
+        f *= Q_UINT64_C(0xc4ceb9fe1a85ec53);
+        f ^= f >> 33;
+        return f;
+    }
+
+private:
+    quint64 m_table = 0;
+    quint64 m_filter = Q_UINT64_C(0xcbf29ce484222325);
+};
+
+/*!
+ * \internal
+ * (used by KCatalog)
+ *
+ * Hash values of a message key, that is of the context and the text.
+ *
+ * They do not depend on the catalog, so they can be computed once
+ * and used for lookups of the same message in several catalogs.
+ *
+ * Exported only for use in autotests.
+ */
+class KI18N_EXPORT KMoKeyHash
+{
+public:
+    /*!
+     * Hashes the key of a message.
+     *
+     * \a msgctxt message context, null if the message has no context
+     *
+     * \a msgid message text
+     */
+    KMoKeyHash(const QByteArray &msgctxt, const QByteArray &msgid);
+
+    /*!
+     * Hashes the key as stored in a catalog, with context and text
+     * joined by the EOT character.
+     */
+    explicit KMoKeyHash(QByteArrayView key);
+
+    /*!
+     * Takes the hash values of the key given to \a hasher.
+     */
+    constexpr explicit KMoKeyHash(const KMoKeyHasher &hasher)
+        : table(hasher.table())
+        , filter(hasher.filter())
+    {
+    }
+
+    /*!
+     * Hash used for the catalog hash table, as computed by msgfmt.
+     */
+    quint32 table = 0;
+
+    /*!
+     * Independent hash used for the negative lookup filter.
+     */
+    quint64 filter = 0;
+};
+
+/*!
+ * \internal
+ * (used by KCatalog)
+ *
+ * Read-only view of a compiled Gettext catalog (.mo file).
+ *
+ * KMoFile answers lookups directly from the catalog data,
+ * using the GNU hash table embedded in the file when present,
+ * and binary search over the sorted message table otherwise.
+ * Plural forms are selected by evaluating the Plural-Forms
+ * expression from the catalog header.
+ *
+ * When loaded, a Bloom filter is built over all message keys
+ * in the catalog, so that lookups of messages which are not in
+ * the catalog are rejected without touching the catalog data.
+ * Applications which are only partially translated, or
+ * have a long chain of fallback languages, look up many such.
+ *
+ * The catalog data is not copied, it must outlive the KMoFile.
+ * Once constructed, the object is immutable and can be used
+ * from several threads at once.
+ *
+ * Exported only for use in autotests.
+ */
+class KI18N_EXPORT KMoFile
+{
+public:
+    /*!
+     * Constructor.
+     *
+     * \a data pointer to the complete contents of the .mo file
+     *
+     * \a size size of the data in bytes
+     */
+    KMoFile(const uchar *data, qsizetype size);
+
+    /*!
+     * Destructor.
+     */
+    ~KMoFile();
+
+    /*!
+     * Returns whether the data is a well-formed .mo file.
+     */
+    bool isValid() const;
+
+    /*!
+     * Returns the character encoding of translations,
+     * as declared in the catalog header.
+     */
+    QByteArray charset() const;
+
+    /*!
+     * Find translation of the given message.
+     *
+     * \a msgctxt message context, null if the message has no context
+     *
+     * \a msgid message text
+     *
+     * \a hash hash values of the message key
+     *
+     * Returns the translation if found, empty view otherwise
+     */
+    QByteArrayView translate(const QByteArray &msgctxt, const QByteArray &msgid, const KMoKeyHash &hash) const;
+
+    /*!
+     * Find translation of the given message with plural forms.
+     *
+     * \a msgctxt message context, null if the message has no context
+     *
+     * \a msgid singular message text
+     *
+     * \a hash hash values of the message key
+     *
+     * \a n number for which the plural form is needed
+     *
+     * Returns the translation in the plural form for \a n if found,
+     * empty view otherwise
+     */
+    QByteArrayView translate(const QByteArray &msgctxt, const QByteArray &msgid, const KMoKeyHash &hash, qulonglong n) const;
+
+    /*!
+     * Find all plural forms of the translation of the given message.
+     *
+     * \a msgctxt message context, null if the message has no context
+     *
+     * \a msgid singular message text
+     *
+     * \a hash hash values of the message key
+     *
+     * Returns the translated forms separated by null bytes if found,
+     * empty view otherwise
+     */
+    QByteArrayView translatePluralForms(const QByteArray &msgctxt, const QByteArray &msgid, const KMoKeyHash &hash) const;
+
+    /*!
+     * Returns the index of the plural form to use for number \a n.
+     */
+    quint64 pluralForm(qulonglong n) const;
+
+private:
+    Q_DISABLE_COPY(KMoFile)
+
+    friend class KMoFileTest;
+
+    quint32 readWord(qsizetype offset) const;
+    QByteArrayView stringAt(quint32 tableOffset, quint32 index) const;
+    QByteArrayView lookup(const QByteArray &msgctxt, const QByteArray &msgid, const KMoKeyHash &hash) const;
+    void parseHeader();
+    void buildFilter();
+    bool filterMayContain(const KMoKeyHash &hash) const;
+
+    const uchar *m_data;
+    qsizetype m_size;
+    bool m_valid = false;
+    bool m_swapped = false;
+    quint32 m_count = 0;
+    quint32 m_originals = 0;
+    quint32 m_translations = 0;
+    quint32 m_hashSize = 0;
+    quint32 m_hashTable = 0;
+    QByteArray m_charset;
+    unsigned long m_pluralCount = 2;
+    std::unique_ptr<KMoPluralExpression> m_plural;
+    QList<quint64> m_filter;
+};
+
+#endif
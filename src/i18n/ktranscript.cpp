@@ -17,20 +17,28 @@
 #include <QJSEngine>
 
 #include <QApplicationStatic>
+#include <QCache>
+#include <QDateTime>
 #include <QDebug>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QHash>
 #include <QIODevice>
 #include <QJSValueIterator>
 #include <QList>
+#include <QMutex>
 #include <QSet>
 #include <QStandardPaths>
 #include <QStringList>
 #include <QTextStream>
+#include <QThread>
 #include <QVariant>
 #include <qendian.h>
 
+#include <memory>
+#include <optional>
+
 class KTranscriptImp;
 class Scriptface;
 
@@ -71,6 +79,15 @@ private:
     QHash<QString, Scriptface *> m_sface;
 };
 
+// Contents of a property map which are read once,
+// for the interpreters of all threads.
+struct SharedPmap {
+    // Property values per phrase, from text maps and compiled maps of format 00.
+    QHash<QByteArray, QHash<QByteArray, QByteArray>> props;
+    // Offsets of property values per phrase, from compiled maps of format 01.
+    QHash<QByteArray, quint64> offsets;
+};
+
 // Script-side transcript interface.
 class Scriptface : public QObject
 {
@@ -81,7 +98,10 @@ public:
 
     // Interface functions.
     Q_INVOKABLE QJSValue load(const QString &name);
-    Q_INVOKABLE QJSValue setcall(const QJSValue &name, const QJSValue &func, const QJSValue &fval = QJSValue::NullValue);
+    Q_INVOKABLE QJSValue setcall(const QJSValue &name,
+                                 const QJSValue &func,
+                                 const QJSValue &fval = QJSValue::NullValue,
+                                 const QJSValue &pure = QJSValue::UndefinedValue);
     Q_INVOKABLE QJSValue hascall(const QString &name);
     Q_INVOKABLE QJSValue acallInternal(const QJSValue &args);
     Q_INVOKABLE QJSValue setcallForall(const QJSValue &name, const QJSValue &func, const QJSValue &fval = QJSValue::NullValue);
@@ -110,10 +130,12 @@ public:
     // Helper methods to interface functions.
     QJSValue load(const QJSValueList &names);
     QJSValue loadProps(const QJSValueList &names);
-    QString loadProps_text(const QString &fpath);
+    QString loadProps_shared(const QString &fpath, QString (Scriptface::*load)(const QString &, SharedPmap &));
+    QString loadProps_text(const QString &fpath, SharedPmap &pmap);
     QString loadProps_bin(const QString &fpath);
-    QString loadProps_bin_00(const QString &fpath);
-    QString loadProps_bin_01(const QString &fpath);
+    QString loadProps_bin_00(const QString &fpath, SharedPmap &pmap);
+    QString loadProps_bin_01(const QString &fpath, SharedPmap &pmap);
+    QString loadProps_bin_02(const QString &fpath);
 
     void put(const QString &propertyName, const QJSValue &value);
 
@@ -140,21 +162,38 @@ public:
     // Ordering of those functions which execute for all messages.
     QList<QString> nameForalls;
 
-    // Property values per phrase (used by *Prop interface calls).
+    // Functions declared pure, whose results depend only on their arguments
+    // and on the phrase properties, and their recent results by call name
+    // and arguments, cleared whenever the properties may change.
+    QSet<QString> pureFuncs;
+    QCache<QString, QString> pureResults{1024};
+
+    // Property values per phrase (used by *Prop interface calls),
+    // as found so far, with the number of the map they come from.
     // Not QStrings, in order to avoid conversion from UTF-8 when
     // loading compiled maps (less latency on startup).
-    QHash<QByteArray, QHash<QByteArray, QByteArray>> phraseProps;
-    // Unresolved property values per phrase,
-    // containing the pointer to compiled pmap file handle and offset in it.
-    struct UnparsedPropInfo {
-        QFile *pmapFile = nullptr;
-        quint64 offset = -1;
+    struct PropInfo {
+        QHash<QByteArray, QByteArray> props;
+        int pmapIndex = -1;
+    };
+    QHash<QByteArray, PropInfo> phraseProps;
+    QHash<QByteArray, QByteArray> findProps(const QByteArray &phrase);
+    // Loaded maps, numbered in the order of loading, the last loaded first.
+    // The properties of a phrase are taken from the last map containing it.
+    struct LoadedPmap {
+        int pmapIndex;
+        // Text maps and compiled maps of formats 00 and 01.
+        std::shared_ptr<const SharedPmap> shared;
+        // Compiled maps of format 01, to read property values from,
+        // and of format 02, memory mapped with an index of phrase keys.
+        QFile *file = nullptr;
+        const char *data = nullptr;
+        qlonglong size = 0;
+        quint32 numSlots = 0;
     };
-    QHash<QByteArray, UnparsedPropInfo> phraseUnparsedProps;
-    QHash<QByteArray, QByteArray> resolveUnparsedProps(const QByteArray &phrase);
-    // Set of loaded pmap files by paths and file handle pointers.
+    QList<LoadedPmap> loadedPmaps;
+    // Set of loaded pmap files by paths.
     QSet<QString> loadedPmapPaths;
-    QSet<QFile *> loadedPmapHandles;
 
     // User config.
     TsConfigGroup config;
@@ -332,6 +371,22 @@ QJSValue variantToJsValue(const QVariant &val)
     }
 }
 
+// ----------------------------------------------------------------------
+// Key of a call by its name and arguments, as passed to eval,
+// distinguishing arguments which are converted differently to JavaScript.
+
+QString pureCallKey(const QList<QVariant> &argv)
+{
+    QString key;
+    for (const QVariant &arg : argv) {
+        key += QString::number(arg.userType());
+        key += QLatin1Char(':');
+        key += arg.toString();
+        key += QChar(0x1f);
+    }
+    return key;
+}
+
 // ----------------------------------------------------------------------
 // Parse ini-style config file,
 // returning content as hash of hashes by group and key.
@@ -408,9 +463,20 @@ static QJSValue throwError(QJSEngine *engine, const QString &message)
     return QJSValue::UndefinedValue;
 }
 
+// Script engines can be used only in the thread which created them,
+// so each thread gets its own interpreters, with the modules loaded anew.
+// Those of the main thread live as long as the application,
+// those of other threads until the thread finishes.
 Q_APPLICATION_STATIC(std::unique_ptr<KTranscriptImp>, globalKTIPtr)
 KTranscriptImp *globalKTI()
 {
+    if (!QThread::isMainThread()) {
+        thread_local std::unique_ptr<KTranscriptImp> threadKTI;
+        if (!threadKTI) {
+            threadKTI = std::make_unique<KTranscriptImp>();
+        }
+        return threadKTI.get();
+    }
     if (!*globalKTIPtr()) {
         *globalKTIPtr() = std::make_unique<KTranscriptImp>();
     }
@@ -436,12 +502,40 @@ void autotestDestroyKTranscriptImp()
 #endif
 #ifndef KTRANSCRIPT_TESTBUILD
 
+// Transcript as used by KLocalizedString,
+// evaluating with the interpreters of the calling thread.
+class KTranscriptThreads : public KTranscript
+{
+public:
+    QString eval(const QList<QVariant> &argv,
+                 const QString &lang,
+                 const QString &ctry,
+                 const QString &msgctxt,
+                 const QHash<QString, QString> &dynctxt,
+                 const QString &msgid,
+                 const QStringList &subs,
+                 const QList<QVariant> &vals,
+                 const QString &ftrans,
+                 QList<QStringList> &mods,
+                 QString &error,
+                 bool &fallback) override
+    {
+        return globalKTI()->eval(argv, lang, ctry, msgctxt, dynctxt, msgid, subs, vals, ftrans, mods, error, fallback);
+    }
+
+    QStringList postCalls(const QString &lang) override
+    {
+        return globalKTI()->postCalls(lang);
+    }
+};
+
 // ----------------------------------------------------------------------
 // Dynamic loading.
 extern "C" {
 KTRANSCRIPT_EXPORT KTranscript *load_transcript()
 {
-    return globalKTI();
+    static KTranscriptThreads transcriptThreads;
+    return &transcriptThreads;
 }
 }
 #endif
@@ -544,6 +638,16 @@ QString KTranscriptImp::eval(const QList<QVariant> &argv,
         return QString();
     }
 
+    // Calls of pure functions with the same arguments
+    // give the same result, without running the function.
+    QString pureKey;
+    if (sface->pureFuncs.contains(funcName)) {
+        pureKey = pureCallKey(argv);
+        if (const QString *result = sface->pureResults.object(pureKey)) {
+            return *result;
+        }
+    }
+
     QJSValue func = sface->funcs[funcName];
     QJSValue fval = sface->fvals[funcName];
 
@@ -574,7 +678,11 @@ QString KTranscriptImp::eval(const QList<QVariant> &argv,
         if (val.isString()) {
             // Good to go.
 
-            return val.toString();
+            const QString result = val.toString();
+            if (!pureKey.isNull()) {
+                sface->pureResults.insert(pureKey, new QString(result));
+            }
+            return result;
         } else {
             // Accept only strings.
 
@@ -677,7 +785,9 @@ Scriptface::Scriptface(const TsConfigGroup &config_, QObject *parent)
 
 Scriptface::~Scriptface()
 {
-    qDeleteAll(loadedPmapHandles);
+    for (const LoadedPmap &pmap : std::as_const(loadedPmaps)) {
+        delete pmap.file;
+    }
 }
 
 void Scriptface::put(const QString &propertyName, const QJSValue &value)
@@ -708,7 +818,7 @@ QJSValue Scriptface::load(const QString &name)
     return load(fnames);
 }
 
-QJSValue Scriptface::setcall(const QJSValue &name, const QJSValue &func, const QJSValue &fval)
+QJSValue Scriptface::setcall(const QJSValue &name, const QJSValue &func, const QJSValue &fval, const QJSValue &pure)
 {
     if (!name.isString()) {
         return throwError(scriptEngine, SPREF("setcall: expected string as first argument"));
@@ -719,11 +829,22 @@ QJSValue Scriptface::setcall(const QJSValue &name, const QJSValue &func, const Q
     if (!(fval.isObject() || fval.isNull())) {
         return throwError(scriptEngine, SPREF("setcall: expected object or null as third argument"));
     }
+    if (!(pure.isBool() || pure.isUndefined())) {
+        return throwError(scriptEngine, SPREF("setcall: expected boolean as fourth argument (when given)"));
+    }
 
     QString qname = name.toString();
     funcs[qname] = func;
     fvals[qname] = fval;
 
+    // Results of the previous function are no longer valid.
+    if (pure.toBool()) {
+        pureFuncs.insert(qname);
+    } else {
+        pureFuncs.remove(qname);
+    }
+    pureResults.clear();
+
     // Register values to keep GC from collecting them. Is this needed?
     put(QStringLiteral("#:f<%1>").arg(qname), func);
     put(QStringLiteral("#:o<%1>").arg(qname), fval);
@@ -949,13 +1070,14 @@ QJSValue Scriptface::loadProps(const QJSValueList &fnames)
             if (haveCompiled) {
                 errorString = loadProps_bin(qfpath);
             } else {
-                errorString = loadProps_text(qfpath);
+                errorString = loadProps_shared(qfpath, &Scriptface::loadProps_text);
             }
             if (!errorString.isEmpty()) {
                 return throwError(scriptEngine, errorString);
             }
             dbgout("Loaded property map: %1", qfpath);
             loadedPmapPaths.insert(qfpath);
+            pureResults.clear();
         }
     }
 
@@ -972,10 +1094,7 @@ QJSValue Scriptface::getProp(const QJSValue &phrase, const QJSValue &prop)
     }
 
     QByteArray qphrase = normKeystr(phrase.toString());
-    QHash<QByteArray, QByteArray> props = phraseProps.value(qphrase);
-    if (props.isEmpty()) {
-        props = resolveUnparsedProps(qphrase);
-    }
+    QHash<QByteArray, QByteArray> props = findProps(qphrase);
     if (!props.isEmpty()) {
         QByteArray qprop = normKeystr(prop.toString());
         QByteArray qval = props.value(qprop);
@@ -1001,8 +1120,12 @@ QJSValue Scriptface::setProp(const QJSValue &phrase, const QJSValue &prop, const
     QByteArray qphrase = normKeystr(phrase.toString());
     QByteArray qprop = normKeystr(prop.toString());
     QByteArray qvalue = value.toString().toUtf8();
-    // Any non-existent key in first or second-level hash will be created.
-    phraseProps[qphrase][qprop] = qvalue;
+    // The property is added to those from the maps loaded so far,
+    // and maps loaded later take precedence.
+    QHash<QByteArray, QByteArray> props = findProps(qphrase);
+    props[qprop] = qvalue;
+    phraseProps[qphrase] = {props, int(loadedPmaps.size()) - 1};
+    pureResults.clear();
     return QJSValue::UndefinedValue;
 }
 
@@ -1172,6 +1295,37 @@ QJSValue Scriptface::getConfNumber(const QJSValue &key, const QJSValue &dval)
 // ----------------------------------------------------------------------
 // Scriptface helpers to interface functions.
 
+// Sources of the modules, by path, with the modification time of the file
+// when it was read. The modules are evaluated by the interpreters of every
+// thread, which then need not read and decode the files again.
+// Only the source is kept: compiled code cannot be shared between script
+// engines, so each interpreter still compiles the modules it evaluates.
+static bool readModuleSource(const QString &fpath, QString &source)
+{
+    static QMutex mutex;
+    static QHash<QString, std::pair<QDateTime, QString>> sources;
+
+    const QDateTime lastModified = QFileInfo(fpath).lastModified();
+    QMutexLocker lock(&mutex);
+    const auto cached = sources.constFind(fpath);
+    if (cached != sources.cend() && cached->first == lastModified) {
+        source = cached->second;
+        return true;
+    }
+    lock.unlock();
+
+    QFile file(fpath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    source = QString::fromUtf8(file.readAll());
+    file.close();
+
+    lock.relock();
+    sources.insert(fpath, {lastModified, source});
+    return true;
+}
+
 QJSValue Scriptface::load(const QJSValueList &fnames)
 {
     if (globalKTI()->currentModulePath.isEmpty()) {
@@ -1188,15 +1342,11 @@ QJSValue Scriptface::load(const QJSValueList &fnames)
         QString qfname = fnames[i].toString();
         QString qfpath = globalKTI()->currentModulePath + QLatin1Char('/') + qfname + QLatin1String(".js");
 
-        QFile file(qfpath);
-        if (!file.open(QIODevice::ReadOnly)) {
+        QString source;
+        if (!readModuleSource(qfpath, source)) {
             return throwError(scriptEngine, SPREF("load: cannot read file '%1'").arg(qfpath));
         }
 
-        QTextStream stream(&file);
-        QString source = stream.readAll();
-        file.close();
-
         QJSValue comp = scriptEngine->evaluate(source, qfpath, 0);
 
         if (comp.isError()) {
@@ -1217,7 +1367,48 @@ QJSValue Scriptface::load(const QJSValueList &fnames)
     return QJSValue::UndefinedValue;
 }
 
-QString Scriptface::loadProps_text(const QString &fpath)
+// Maps which are not memory mapped are read once, for the interpreters
+// of all threads, and kept as long as the application runs.
+QString Scriptface::loadProps_shared(const QString &fpath, QString (Scriptface::*load)(const QString &, SharedPmap &))
+{
+    static QMutex mutex;
+    static QHash<QString, std::pair<QDateTime, std::shared_ptr<const SharedPmap>>> pmaps;
+
+    std::shared_ptr<const SharedPmap> pmap;
+    const QDateTime lastModified = QFileInfo(fpath).lastModified();
+    QMutexLocker lock(&mutex);
+    const auto cached = pmaps.constFind(fpath);
+    if (cached != pmaps.cend() && cached->first == lastModified) {
+        pmap = cached->second;
+    }
+    lock.unlock();
+
+    if (!pmap) {
+        auto readPmap = std::make_shared<SharedPmap>();
+        const QString errorString = (this->*load)(fpath, *readPmap);
+        if (!errorString.isEmpty()) {
+            return errorString;
+        }
+        pmap = readPmap;
+        lock.relock();
+        pmaps.insert(fpath, {lastModified, pmap});
+        lock.unlock();
+    }
+
+    LoadedPmap loaded{int(loadedPmaps.size()), pmap};
+    if (!pmap->offsets.isEmpty()) {
+        // Property values are read from the file as needed.
+        loaded.file = new QFile(fpath);
+        if (!loaded.file->open(QIODevice::ReadOnly)) {
+            delete loaded.file;
+            return SPREF("loadProps: cannot read file '%1'").arg(fpath);
+        }
+    }
+    loadedPmaps.prepend(loaded);
+    return QString();
+}
+
+QString Scriptface::loadProps_text(const QString &fpath, SharedPmap &pmap)
 {
     QFile file(fpath);
     if (!file.open(QIODevice::ReadOnly)) {
@@ -1310,7 +1501,7 @@ QString Scriptface::loadProps_text(const QString &fpath)
                     // Add collected entry into global store,
                     // once for each entry key (QHash implicitly shared).
                     for (const QByteArray &ekey : std::as_const(ekeys)) {
-                        phraseProps[ekey] = props;
+                        pmap.props[ekey] = props;
                     }
 
                     i += 1;
@@ -1416,15 +1607,17 @@ QString Scriptface::loadProps_bin(const QString &fpath)
 
     // Choose pmap loader based on header.
     if (head == "TSPMAP00") {
-        return loadProps_bin_00(fpath);
+        return loadProps_shared(fpath, &Scriptface::loadProps_bin_00);
     } else if (head == "TSPMAP01") {
-        return loadProps_bin_01(fpath);
+        return loadProps_shared(fpath, &Scriptface::loadProps_bin_01);
+    } else if (head == "TSPMAP02") {
+        return loadProps_bin_02(fpath);
     } else {
         return SPREF("loadProps: unknown version of compiled map '%1'").arg(fpath);
     }
 }
 
-QString Scriptface::loadProps_bin_00(const QString &fpath)
+QString Scriptface::loadProps_bin_00(const QString &fpath, SharedPmap &pmap)
 {
     QFile file(fpath);
     if (!file.open(QIODevice::ReadOnly)) {
@@ -1491,7 +1684,7 @@ QString Scriptface::loadProps_bin_00(const QString &fpath)
         // Add collected entry into global store,
         // once for each entry key (QHash implicitly shared).
         for (const QByteArray &ekey : std::as_const(ekeys)) {
-            phraseProps[ekey] = props;
+            pmap.props[ekey] = props;
         }
     }
 
@@ -1504,10 +1697,10 @@ END_PROP_PARSE:
     return QString();
 }
 
-QString Scriptface::loadProps_bin_01(const QString &fpath)
+QString Scriptface::loadProps_bin_01(const QString &fpath, SharedPmap &pmap)
 {
-    QFile *file = new QFile(fpath);
-    if (!file->open(QIODevice::ReadOnly)) {
+    QFile file(fpath);
+    if (!file.open(QIODevice::ReadOnly)) {
         return SPREF("loadProps: cannot read file '%1'").arg(fpath);
     }
 
@@ -1515,7 +1708,7 @@ QString Scriptface::loadProps_bin_01(const QString &fpath)
     qlonglong pos;
 
     // Read the header and number and length of entry keys.
-    fstr = file->read(8 + 4 + 8);
+    fstr = file.read(8 + 4 + 8);
     pos = 0;
     QByteArray head = fstr.left(8);
     pos += 8;
@@ -1526,41 +1719,162 @@ QString Scriptface::loadProps_bin_01(const QString &fpath)
     quint64 lenekeys = bin_read_int64(fstr, fstr.size(), pos);
 
     // Read entry keys.
-    fstr = file->read(lenekeys);
+    fstr = file.read(lenekeys);
     pos = 0;
     for (quint32 i = 0; i < numekeys; ++i) {
         QByteArray ekey = bin_read_string(fstr, lenekeys, pos);
         quint64 offset = bin_read_int64(fstr, lenekeys, pos);
-        phraseUnparsedProps[ekey] = {file, offset};
+        pmap.offsets[ekey] = offset;
     }
 
     // // Read property keys.
     // ...when it becomes necessary
 
-    loadedPmapHandles.insert(file);
     return QString();
 }
 
-QHash<QByteArray, QByteArray> Scriptface::resolveUnparsedProps(const QByteArray &phrase)
+// Layout of compiled maps of format 02, after the header:
+// - number of slots in the index of phrase keys, 32-bit
+// - the slots, each with the hash of a phrase key, 32-bit, and the offset
+//   of its entry, 64-bit, or 0 for empty slots; keys are placed into
+//   the slot at their hash modulo the number of slots, or the next free one
+// - entries, each a phrase key string and the offset of its properties, 64-bit
+// - properties, as in format 01.
+static const qlonglong pmap02IndexPos = 8 + 4;
+static const qlonglong pmap02SlotSize = 4 + 8;
+
+// Hash of a phrase key in compiled maps of format 02 (32-bit FNV-1a).
+// Must do the same as key_hash() in ts-pmap-compile.py.
+static quint32 pmap02KeyHash(const QByteArray &key)
 {
-    auto [file, offset] = phraseUnparsedProps.value(phrase);
-    QHash<QByteArray, QByteArray> props;
-    if (file && file->seek(offset)) {
-        QByteArray fstr = file->read(4 + 4);
-        qlonglong pos = 0;
-        quint32 numpkeys = bin_read_int(fstr, fstr.size(), pos);
-        quint32 lenpkeys = bin_read_int(fstr, fstr.size(), pos);
-        fstr = file->read(lenpkeys);
-        pos = 0;
-        for (quint32 i = 0; i < numpkeys; ++i) {
-            QByteArray pkey = bin_read_string(fstr, lenpkeys, pos);
-            QByteArray pval = bin_read_string(fstr, lenpkeys, pos);
-            props[pkey] = pval;
+    quint32 hash = 0x811c9dc5;
+    for (const char c : key) {
+        hash = (hash ^ uchar(c)) * 0x01000193;
+    }
+    return hash;
+}
+
+QString Scriptface::loadProps_bin_02(const QString &fpath)
+{
+    // The map is only mapped into memory, and its pages
+    // read as the properties of phrases are looked up.
+    QFile *file = new QFile(fpath);
+    if (!file->open(QIODevice::ReadOnly)) {
+        delete file;
+        return SPREF("loadProps: cannot read file '%1'").arg(fpath);
+    }
+    const qlonglong size = file->size();
+    const char *data = reinterpret_cast<const char *>(file->map(0, size));
+    if (!data) {
+        delete file;
+        return SPREF("loadProps: cannot map file '%1'").arg(fpath);
+    }
+
+    qlonglong pos = 8;
+    const quint32 numSlots = bin_read_int(data, size, pos);
+    if (pos < 0 || numSlots == 0 || pmap02IndexPos + numSlots * pmap02SlotSize > size) {
+        delete file;
+        return SPREF("loadProps: corrupt compiled map '%1'").arg(fpath);
+    }
+
+    LoadedPmap loaded{int(loadedPmaps.size()), nullptr};
+    loaded.file = file;
+    loaded.data = data;
+    loaded.size = size;
+    loaded.numSlots = numSlots;
+    loadedPmaps.prepend(loaded);
+    return QString();
+}
+
+// Find properties of the phrase in a compiled map of format 02.
+// The phrase may be in the map with no properties.
+static std::optional<QHash<QByteArray, QByteArray>> pmap02FindProps(const char *data, qlonglong size, quint32 numSlots, const QByteArray &phrase)
+{
+    const quint32 hash = pmap02KeyHash(phrase);
+    quint32 slot = hash % numSlots;
+    for (quint32 i = 0; i < numSlots; ++i) {
+        qlonglong pos = pmap02IndexPos + slot * pmap02SlotSize;
+        const quint32 slotHash = bin_read_int(data, size, pos);
+        qlonglong epos = bin_read_int64(data, size, pos);
+        if (pos < 0 || epos == 0) { // corrupt map or empty slot, no such phrase
+            return std::nullopt;
+        }
+        if (slotHash == hash) {
+            // Compare the key in place.
+            const quint32 keyLength = bin_read_int(data, size, epos);
+            if (epos >= 0 && keyLength == quint32(phrase.size()) && epos + keyLength <= size
+                && memcmp(data + epos, phrase.constData(), keyLength) == 0) {
+                epos += keyLength;
+                qlonglong ppos = bin_read_int64(data, size, epos);
+                if (epos < 0 || ppos < 0 || ppos > size) { // corrupt entry
+                    return std::nullopt;
+                }
+                const quint32 numpkeys = bin_read_int(data, size, ppos);
+                bin_read_int(data, size, ppos); // length of properties
+                QHash<QByteArray, QByteArray> props;
+                for (quint32 j = 0; j < numpkeys && ppos >= 0; ++j) {
+                    QByteArray pkey = bin_read_string(data, size, ppos);
+                    QByteArray pval = bin_read_string(data, size, ppos);
+                    props[pkey] = pval;
+                }
+                if (ppos < 0) { // corrupt properties
+                    return std::nullopt;
+                }
+                return props;
+            }
         }
-        phraseProps[phrase] = props;
-        phraseUnparsedProps.remove(phrase);
+        slot = (slot + 1) % numSlots;
+    }
+    return std::nullopt;
+}
+
+// Find properties of the phrase in a compiled map of format 01.
+static std::optional<QHash<QByteArray, QByteArray>> pmap01FindProps(QFile *file, const QHash<QByteArray, quint64> &offsets, const QByteArray &phrase)
+{
+    const auto offset = offsets.constFind(phrase);
+    if (offset == offsets.cend() || !file->seek(*offset)) {
+        return std::nullopt;
+    }
+    QByteArray fstr = file->read(4 + 4);
+    qlonglong pos = 0;
+    quint32 numpkeys = bin_read_int(fstr, fstr.size(), pos);
+    quint32 lenpkeys = bin_read_int(fstr, fstr.size(), pos);
+    fstr = file->read(lenpkeys);
+    pos = 0;
+    QHash<QByteArray, QByteArray> props;
+    for (quint32 i = 0; i < numpkeys; ++i) {
+        QByteArray pkey = bin_read_string(fstr, lenpkeys, pos);
+        QByteArray pval = bin_read_string(fstr, lenpkeys, pos);
+        props[pkey] = pval;
     }
     return props;
 }
 
+QHash<QByteArray, QByteArray> Scriptface::findProps(const QByteArray &phrase)
+{
+    PropInfo info = phraseProps.value(phrase);
+
+    // Look into the maps loaded after the one the properties
+    // found so far come from, the last loaded first.
+    for (const LoadedPmap &pmap : std::as_const(loadedPmaps)) {
+        if (pmap.pmapIndex <= info.pmapIndex) {
+            break;
+        }
+        std::optional<QHash<QByteArray, QByteArray>> props;
+        if (pmap.data) {
+            props = pmap02FindProps(pmap.data, pmap.size, pmap.numSlots, phrase);
+        } else if (pmap.file) {
+            props = pmap01FindProps(pmap.file, pmap.shared->offsets, phrase);
+        } else if (const auto it = pmap.shared->props.constFind(phrase); it != pmap.shared->props.cend()) {
+            props = *it;
+        }
+        if (props) {
+            info = {*props, pmap.pmapIndex};
+            phraseProps[phrase] = info;
+            break;
+        }
+    }
+    return info.props;
+}
+
 #include "ktranscript.moc"
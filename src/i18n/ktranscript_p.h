@@ -20,6 +20,8 @@
  *
  * KTranscript provides support for programmable translations.
  * The class is abstract in order to facilitate dynamic loading.
+ * Evaluations in each thread are done by interpreters of that thread,
+ * so scripting modules must be passed for loading in every thread.
  */
 class KTranscript
 {
@@ -36,7 +38,8 @@ public:
      * \a subs substitutions for message placeholders
      * \a vals values that were formatted to substitutions
      * \a ftrans finalized ordinary translation
-     * \a mods scripting modules to load; the list is cleared after loading
+     * \a mods scripting modules to load in the calling thread;
+     *        the list is cleared after loading
      * \a error set to the message detailing the problem, if the script
                     failed; set to empty otherwise
      * \a fallback set to true if the script requested fallback to ordinary
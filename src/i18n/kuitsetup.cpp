@@ -4,11 +4,15 @@
     SPDX-License-Identifier: LGPL-2.0-or-later
 */
 
+#include <QCache>
 #include <QDir>
+#include <QMutex>
 #include <QRegularExpression>
 #include <QSet>
 #include <QStack>
-#include <QXmlStreamReader>
+
+#include <atomic>
+#include <memory>
 
 #include <klazylocalizedstring.h>
 #include <klocalizedstring.h>
@@ -21,31 +25,173 @@
 #define QSL(x) QStringLiteral(x)
 #define QL1C(x) QLatin1Char(x)
 
+// Characters which have to be escaped in XML text, as bits by their code.
+static constexpr quint64 s_markupChars =
+    (Q_UINT64_C(1) << '&') | (Q_UINT64_C(1) << '<') | (Q_UINT64_C(1) << '>') | (Q_UINT64_C(1) << '\'') | (Q_UINT64_C(1) << '"');
+
+static bool isMarkupChar(QChar c)
+{
+    return c.unicode() <= '>' && (s_markupChars >> c.unicode()) & 1;
+}
+
+// Position of the first character from the given one on
+// which has to be escaped in XML text, -1 if there is none.
+static qsizetype indexOfMarkupChar(QStringView text, qsizetype from)
+{
+    const QChar *const begin = text.data();
+    const QChar *const end = begin + text.size();
+    for (const QChar *c = begin + from; c != end; ++c) {
+        if (isMarkupChar(*c)) {
+            return c - begin;
+        }
+    }
+    return -1;
+}
+
+static QLatin1String markupCharEntity(QChar c)
+{
+    switch (c.unicode()) {
+    case '&':
+        return QL1S("&amp;");
+    case '<':
+        return QL1S("&lt;");
+    case '>':
+        return QL1S("&gt;");
+    case '\'':
+        return QL1S("&apos;");
+    default: // '"'
+        return QL1S("&quot;");
+    }
+}
+
+static void appendEscaped(QString &target, QChar c)
+{
+    if (isMarkupChar(c)) {
+        target += markupCharEntity(c);
+    } else {
+        target += c;
+    }
+}
+
+// Character of a named entity known to KUIT, null if not known.
+static QChar namedEntity(QStringView name)
+{
+    switch (name.size()) {
+    case 2:
+        if (name == QL1S("lt")) {
+            return QL1C('<');
+        } else if (name == QL1S("gt")) {
+            return QL1C('>');
+        }
+        break;
+    case 3:
+        if (name == QL1S("amp")) {
+            return QL1C('&');
+        }
+        break;
+    case 4:
+        if (name == QL1S("apos")) {
+            return QL1C('\'');
+        } else if (name == QL1S("quot")) {
+            return QL1C('"');
+        } else if (name == QL1S("nbsp")) {
+            return QChar(0xa0);
+        }
+        break;
+    }
+    return QChar();
+}
+
+// Match an entity in KUIT sense at the ampersand at the given position:
+// a lowercase name, a decimal or a hexadecimal character reference,
+// followed by semicolon. Returns the position after the entity and
+// sets the text between ampersand and semicolon, or returns -1.
+static qsizetype matchEntity(QStringView text, qsizetype pos, QStringView &entity)
+{
+    qsizetype end = pos + 1;
+    const bool numeric = end < text.size() && text[end] == QL1C('#');
+    const bool hex = numeric && end + 1 < text.size() && text[end + 1] == QL1C('x');
+    end += numeric + hex;
+    const qsizetype start = end;
+    while (end < text.size()) {
+        const char16_t c = text[end].unicode();
+        const bool valid = hex ? ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))
+            : numeric          ? (c >= '0' && c <= '9')
+                               : (c >= 'a' && c <= 'z');
+        if (!valid) {
+            break;
+        }
+        ++end;
+    }
+    if (end == start || end == text.size() || text[end] != QL1C(';')) {
+        return -1;
+    }
+    entity = text.sliced(pos + 1, end - pos - 1);
+    return end + 1;
+}
+
 QString Kuit::escape(const QString &text)
 {
-    int tlen = text.length();
+    // Most texts have nothing to escape and are returned as they are,
+    // in others the runs between markup characters are copied whole.
+    qsizetype next = indexOfMarkupChar(text, 0);
+    if (next < 0) {
+        return text;
+    }
+
     QString ntext;
-    ntext.reserve(tlen);
-    for (int i = 0; i < tlen; ++i) {
-        QChar c = text[i];
-        if (c == QL1C('&')) {
-            ntext += QStringLiteral("&amp;");
-        } else if (c == QL1C('<')) {
-            ntext += QStringLiteral("&lt;");
-        } else if (c == QL1C('>')) {
-            ntext += QStringLiteral("&gt;");
-        } else if (c == QL1C('\'')) {
-            ntext += QStringLiteral("&apos;");
-        } else if (c == QL1C('"')) {
-            ntext += QStringLiteral("&quot;");
-        } else {
-            ntext += c;
-        }
+    ntext.reserve(text.length() + 16);
+    qsizetype pos = 0;
+    while (next >= 0) {
+        ntext += QStringView(text).sliced(pos, next - pos);
+        ntext += markupCharEntity(text[next]);
+        pos = next + 1;
+        next = indexOfMarkupChar(text, pos);
     }
+    ntext += QStringView(text).sliced(pos);
 
     return ntext;
 }
 
+// Replace entities by the characters they stand for,
+// leaving unknown entities as they are.
+static QString resolveEntities(const QString &text)
+{
+    qsizetype amp = text.indexOf(QL1C('&'));
+    if (amp < 0) {
+        return text;
+    }
+
+    QString plain;
+    plain.reserve(text.size());
+    qsizetype pos = 0;
+    while (amp >= 0) {
+        QStringView entity;
+        const qsizetype end = matchEntity(text, amp, entity);
+        if (end < 0) {
+            amp = text.indexOf(QL1C('&'), amp + 1);
+            continue;
+        }
+        QChar c;
+        bool known;
+        if (entity[0] == QL1C('#')) { // numeric character entity
+            const int code = entity[1] == QL1C('x') ? entity.sliced(2).toInt(&known, 16) : entity.sliced(1).toInt(&known, 10);
+            c = QChar(code);
+        } else {
+            c = namedEntity(entity);
+            known = !c.isNull();
+        }
+        if (known) {
+            plain += QStringView(text).sliced(pos, amp - pos);
+            plain += c;
+            pos = end;
+        }
+        amp = text.indexOf(QL1C('&'), end);
+    }
+    plain += QStringView(text).sliced(pos);
+    return plain;
+}
+
 // Truncates the string, for output of long messages.
 // (But don't truncate too much otherwise it's impossible to determine
 // which message is faulty if many messages have the same beginning).
@@ -89,27 +235,371 @@ static void parseUiMarker(const QString &context_, QString &roleName, QString &c
     }
 }
 
-// Custom entity resolver for QXmlStreamReader.
-class KuitEntityResolver : public QXmlStreamEntityResolver
+namespace
+{
+// Reader of KUIT markup in a single pass over the message.
+// KUIT needs only elements, attributes and entities out of XML,
+// and &-shortcut markers must be told apart from entities on the way,
+// which a general XML reader could only do with the text rewritten first.
+class KuitTokenizer
 {
 public:
-    void setEntities(const QHash<QString, QString> &entities)
+    enum Token {
+        Characters,
+        StartElement,
+        EndElement,
+        EndOfText,
+        Invalid,
+    };
+
+    struct Attribute {
+        QStringView name;
+        QString value;
+    };
+
+    explicit KuitTokenizer(QStringView text)
+        : m_text(text)
+    {
+    }
+
+    Token readNext();
+
+    // Name of the last start or end element.
+    QStringView name() const
+    {
+        return m_name;
+    }
+
+    // Attributes of the last start element, with entities resolved.
+    const QList<Attribute> &attributes() const
+    {
+        return m_attributes;
+    }
+
+    // The last run of characters. Entities of XML markup characters
+    // are kept as they are, to be resolved when the text is finalized,
+    // and &-shortcut markers become &amp; for the same reason.
+    const QString &characters() const
     {
-        entityMap = entities;
+        return m_characters;
     }
 
-    QString resolveUndeclaredEntity(const QString &name) override
+    const QString &errorString() const
     {
-        QString value = entityMap.value(name);
-        // This will return empty string if the entity name is not known,
-        // which will make QXmlStreamReader signal unknown entity error.
-        return value;
+        return m_error;
     }
 
 private:
-    QHash<QString, QString> entityMap;
+    QChar at(qsizetype pos) const
+    {
+        return pos < m_text.size() ? m_text[pos] : QChar();
+    }
+
+    Token fail(const QString &error)
+    {
+        m_error = error;
+        return Invalid;
+    }
+
+    bool skipWhitespace();
+    bool readName(QStringView &name);
+    bool readEntity(QString &target, bool escapeMarkup);
+    Token readStartElement();
+    Token readEndElement();
+    Token readCharacters();
+    Token readCData();
+
+    const QStringView m_text;
+    qsizetype m_pos = 0;
+    QStringView m_name;
+    QList<Attribute> m_attributes;
+    QString m_characters;
+    QString m_error;
+    QList<QStringView> m_openElements;
+    bool m_closeEmptyElement = false;
 };
 
+bool isNameStartChar(QChar c)
+{
+    return c.isLetter() || c == QL1C('_') || c == QL1C(':');
+}
+
+bool isNameChar(QChar c)
+{
+    return c.isLetterOrNumber() || c.isMark() || c == QL1C('_') || c == QL1C(':') || c == QL1C('-') || c == QL1C('.');
+}
+
+bool isXmlWhitespace(QChar c)
+{
+    return c == QL1C(' ') || c == QL1C('\n') || c == QL1C('\t') || c == QL1C('\r');
+}
+
+bool isXmlChar(char32_t c)
+{
+    return c == 0x9 || c == 0xa || c == 0xd || (c >= 0x20 && c <= 0xd7ff) || (c >= 0xe000 && c <= 0xfffd) || (c >= 0x10000 && c <= 0x10ffff);
+}
+
+KuitTokenizer::Token KuitTokenizer::readNext()
+{
+    if (m_closeEmptyElement) {
+        m_closeEmptyElement = false;
+        m_openElements.removeLast();
+        return EndElement;
+    }
+
+    while (m_pos < m_text.size()) {
+        if (m_text[m_pos] != QL1C('<')) {
+            return readCharacters();
+        }
+        const QStringView rest = m_text.mid(m_pos);
+        if (rest.startsWith(QL1S("</"))) {
+            return readEndElement();
+        } else if (rest.startsWith(QL1S("<!--"))) {
+            const qsizetype end = m_text.indexOf(QL1S("-->"), m_pos + 4);
+            if (end < 0) {
+                return fail(QSL("Unterminated comment."));
+            }
+            m_pos = end + 3;
+        } else if (rest.startsWith(QL1S("<?"))) {
+            const qsizetype end = m_text.indexOf(QL1S("?>"), m_pos + 2);
+            if (end < 0) {
+                return fail(QSL("Unterminated processing instruction."));
+            }
+            m_pos = end + 2;
+        } else if (rest.startsWith(QL1S("<![CDATA["))) {
+            return readCData();
+        } else {
+            return readStartElement();
+        }
+    }
+
+    if (!m_openElements.isEmpty()) {
+        return fail(QSL("Opening and ending tag mismatch."));
+    }
+    return EndOfText;
+}
+
+bool KuitTokenizer::skipWhitespace()
+{
+    const qsizetype start = m_pos;
+    while (m_pos < m_text.size() && isXmlWhitespace(m_text[m_pos])) {
+        ++m_pos;
+    }
+    return m_pos > start;
+}
+
+bool KuitTokenizer::readName(QStringView &name)
+{
+    const qsizetype start = m_pos;
+    if (!isNameStartChar(at(m_pos))) {
+        return false;
+    }
+    ++m_pos;
+    while (m_pos < m_text.size() && isNameChar(m_text[m_pos])) {
+        ++m_pos;
+    }
+    name = m_text.sliced(start, m_pos - start);
+    return true;
+}
+
+// Read an entity at the current ampersand, if it is one in KUIT sense
+// (a lowercase name or a character reference followed by semicolon),
+// otherwise append the ampersand itself as a &-shortcut marker.
+// Returns false if the entity is not known or not a valid character.
+bool KuitTokenizer::readEntity(QString &target, bool escapeMarkup)
+{
+    QStringView entity;
+    const qsizetype end = matchEntity(m_text, m_pos, entity);
+    if (end < 0) { // not an entity
+        target += escapeMarkup ? QL1S("&amp;") : QL1S("&");
+        ++m_pos;
+        return true;
+    }
+
+    QChar c;
+    if (entity[0] == QL1C('#')) {
+        bool ok;
+        const uint code = entity[1] == QL1C('x') ? entity.sliced(2).toUInt(&ok, 16) : entity.sliced(1).toUInt(&ok, 10);
+        if (!ok || !isXmlChar(code)) {
+            return false;
+        }
+        if (QChar::requiresSurrogates(code)) {
+            target += QChar(QChar::highSurrogate(code));
+            target += QChar(QChar::lowSurrogate(code));
+            m_pos = end;
+            return true;
+        }
+        c = QChar(char16_t(code));
+    } else {
+        c = namedEntity(entity);
+        if (c.isNull()) {
+            return false;
+        }
+    }
+    if (escapeMarkup) {
+        appendEscaped(target, c);
+    } else {
+        target += c;
+    }
+    m_pos = end;
+    return true;
+}
+
+KuitTokenizer::Token KuitTokenizer::readStartElement()
+{
+    ++m_pos; // <
+    if (!readName(m_name)) {
+        return fail(QSL("Expected element name."));
+    }
+
+    m_attributes.clear();
+    for (;;) {
+        const bool separated = skipWhitespace();
+        const QChar c = at(m_pos);
+        if (c == QL1C('>')) {
+            ++m_pos;
+            m_openElements.append(m_name);
+            return StartElement;
+        } else if (c == QL1C('/')) {
+            if (at(m_pos + 1) != QL1C('>')) {
+                return fail(QSL("Expected '>' after '/'."));
+            }
+            m_pos += 2;
+            m_openElements.append(m_name);
+            m_closeEmptyElement = true;
+            return StartElement;
+        } else if (c.isNull()) {
+            return fail(QSL("Premature end of message in element '%1'.").arg(m_name));
+        } else if (!separated) {
+            return fail(QSL("Expected whitespace before attribute."));
+        }
+
+        Attribute attribute;
+        if (!readName(attribute.name)) {
+            return fail(QSL("Expected attribute name."));
+        }
+        for (const Attribute &other : std::as_const(m_attributes)) {
+            if (other.name == attribute.name) {
+                return fail(QSL("Attribute '%1' redefined.").arg(attribute.name));
+            }
+        }
+        skipWhitespace();
+        if (at(m_pos) != QL1C('=')) {
+            return fail(QSL("Expected '=' after attribute name."));
+        }
+        ++m_pos;
+        skipWhitespace();
+        const QChar quote = at(m_pos);
+        if (quote != QL1C('\'') && quote != QL1C('"')) {
+            return fail(QSL("Expected quoted attribute value."));
+        }
+        ++m_pos;
+        for (;;) {
+            const QChar v = at(m_pos);
+            if (v == quote) {
+                ++m_pos;
+                break;
+            } else if (v.isNull() && m_pos >= m_text.size()) {
+                return fail(QSL("Premature end of message in attribute value."));
+            } else if (v == QL1C('<')) {
+                return fail(QSL("Character '<' in attribute value."));
+            } else if (v == QL1C('&')) {
+                if (!readEntity(attribute.value, false)) {
+                    return fail(QSL("Unknown or invalid entity."));
+                }
+            } else if (v == QL1C('\r') && at(m_pos + 1) == QL1C('\n')) {
+                ++m_pos;
+            } else if (isXmlWhitespace(v)) {
+                // Attribute value normalization.
+                attribute.value += QL1C(' ');
+                ++m_pos;
+            } else if (!isXmlChar(v.unicode())) {
+                return fail(QSL("Invalid character in attribute value."));
+            } else {
+                attribute.value += v;
+                ++m_pos;
+            }
+        }
+        m_attributes.append(std::move(attribute));
+    }
+}
+
+KuitTokenizer::Token KuitTokenizer::readEndElement()
+{
+    m_pos += 2; // </
+    if (!readName(m_name)) {
+        return fail(QSL("Expected element name."));
+    }
+    skipWhitespace();
+    if (at(m_pos) != QL1C('>')) {
+        return fail(QSL("Expected '>' after element name."));
+    }
+    ++m_pos;
+    if (m_openElements.isEmpty() || m_openElements.last() != m_name) {
+        return fail(QSL("Opening and ending tag mismatch."));
+    }
+    m_openElements.removeLast();
+    return EndElement;
+}
+
+KuitTokenizer::Token KuitTokenizer::readCharacters()
+{
+    m_characters.resize(0);
+    while (m_pos < m_text.size()) {
+        // Copy the plain part in one go.
+        qsizetype end = m_pos;
+        while (end < m_text.size()) {
+            const char16_t c = m_text[end].unicode();
+            if (c == '<' || c == '&' || c == '>' || c == '\'' || c == '"' || c == '\r' || c < 0x20 || c >= 0xfffe) {
+                break;
+            }
+            ++end;
+        }
+        m_characters += m_text.sliced(m_pos, end - m_pos);
+        m_pos = end;
+
+        const QChar c = at(m_pos);
+        if (m_pos >= m_text.size() || c == QL1C('<')) {
+            break;
+        } else if (c == QL1C('&')) {
+            if (!readEntity(m_characters, true)) {
+                return fail(QSL("Unknown or invalid entity."));
+            }
+        } else if (c == QL1C('\r')) {
+            // End of line normalization.
+            m_characters += QL1C('\n');
+            m_pos += at(m_pos + 1) == QL1C('\n') ? 2 : 1;
+        } else if (c == QL1C('\n') || c == QL1C('\t')) {
+            m_characters += c;
+            ++m_pos;
+        } else if (c == QL1C('>') && m_text.sliced(0, m_pos).endsWith(QL1S("]]"))) {
+            return fail(QSL("Sequence ']]>' not allowed in content."));
+        } else if (c.unicode() < 0x20 || c.unicode() >= 0xfffe) {
+            return fail(QSL("Invalid character."));
+        } else {
+            appendEscaped(m_characters, c);
+            ++m_pos;
+        }
+    }
+    return Characters;
+}
+
+KuitTokenizer::Token KuitTokenizer::readCData()
+{
+    m_pos += 9; // <![CDATA[
+    const qsizetype end = m_text.indexOf(QL1S("]]>"), m_pos);
+    if (end < 0) {
+        return fail(QSL("Unterminated CDATA section."));
+    }
+    m_characters.resize(0);
+    for (; m_pos < end; ++m_pos) {
+        appendEscaped(m_characters, m_text[m_pos]);
+    }
+    m_pos += 3;
+    return Characters;
+}
+}
+
 namespace Kuit
 {
 enum class Role { // UI marker roles
@@ -160,10 +650,6 @@ enum Cue { // UI marker subcues
 class KuitStaticData
 {
 public:
-    QHash<QString, QString> xmlEntities;
-    QHash<QString, QString> xmlEntitiesInverse;
-    KuitEntityResolver xmlEntityResolver;
-
     QHash<QString, Kuit::Role> rolesByName;
     QHash<QString, Kuit::Cue> cuesByName;
     QHash<QString, Kuit::VisualFormat> formatsByName;
@@ -174,7 +660,13 @@ public:
     QHash<Kuit::VisualFormat, KLocalizedString> guiPathDelim;
     QHash<QString, KLocalizedString> keyNames;
 
-    QHash<QByteArray, KuitSetup *> domainSetups;
+    // Setups by domain, replaced by an extended copy when a setup is added,
+    // so that they can be looked up without locking. A replaced copy
+    // is freed once the last lookup still using it is done.
+    std::atomic<std::shared_ptr<const QHash<QByteArray, KuitSetup *>>> domainSetups;
+    QMutex domainSetupsMutex;
+    // Changed whenever a domain setup is modified.
+    QAtomicInt setupGeneration;
 
     KuitStaticData();
     ~KuitStaticData();
@@ -182,8 +674,6 @@ public:
     KuitStaticData(const KuitStaticData &) = delete;
     KuitStaticData &operator=(const KuitStaticData &) = delete;
 
-    void setXmlEntityData();
-
     void setUiMarkerData();
 
     void setKeyName(const KLazyLocalizedString &keyName);
@@ -193,42 +683,17 @@ public:
 };
 
 KuitStaticData::KuitStaticData()
+    : domainSetups(std::make_shared<const QHash<QByteArray, KuitSetup *>>())
 {
-    setXmlEntityData();
     setUiMarkerData();
     setTextTransformData();
 }
 
 KuitStaticData::~KuitStaticData()
 {
-    qDeleteAll(domainSetups);
+    qDeleteAll(*domainSetups.load(std::memory_order_relaxed));
 }
 
-void KuitStaticData::setXmlEntityData()
-{
-    QString LT = QStringLiteral("lt");
-    QString GT = QStringLiteral("gt");
-    QString AMP = QStringLiteral("amp");
-    QString APOS = QStringLiteral("apos");
-    QString QUOT = QStringLiteral("quot");
-
-    // Default XML entities, direct and inverse mapping.
-    xmlEntities[LT] = QString(QL1C('<'));
-    xmlEntities[GT] = QString(QL1C('>'));
-    xmlEntities[AMP] = QString(QL1C('&'));
-    xmlEntities[APOS] = QString(QL1C('\''));
-    xmlEntities[QUOT] = QString(QL1C('"'));
-    xmlEntitiesInverse[QString(QL1C('<'))] = LT;
-    xmlEntitiesInverse[QString(QL1C('>'))] = GT;
-    xmlEntitiesInverse[QString(QL1C('&'))] = AMP;
-    xmlEntitiesInverse[QString(QL1C('\''))] = APOS;
-    xmlEntitiesInverse[QString(QL1C('"'))] = QUOT;
-
-    // Custom XML entities.
-    xmlEntities[QStringLiteral("nbsp")] = QString(QChar(0xa0));
-
-    xmlEntityResolver.setEntities(xmlEntities);
-}
 // clang-format off
 void KuitStaticData::setUiMarkerData()
 {
@@ -461,85 +926,96 @@ static QString attributeSetKey(const QStringList &attribNames_)
     return key;
 }
 
+// Formatting of a tag with a particular set of attributes into a visual format.
+class KuitTagFormat
+{
+public:
+    bool isDefined = false;
+    QStringList attributeOrder;
+    KLocalizedString pattern;
+    Kuit::TagFormatter formatter = nullptr;
+};
+
 class KuitTag
 {
 public:
     QString name;
     Kuit::TagClass type;
-    QSet<QString> knownAttribs;
-    QHash<QString, QHash<Kuit::VisualFormat, QStringList>> attributeOrders;
-    QHash<QString, QHash<Kuit::VisualFormat, KLocalizedString>> patterns;
-    QHash<QString, QHash<Kuit::VisualFormat, Kuit::TagFormatter>> formatters;
-    int leadingNewlines;
-
-    KuitTag(const QString &_name, Kuit::TagClass _type)
+    // Index of the tag in its setup.
+    int id = -1;
+    // Known attributes, by their bit in attribute sets.
+    QHash<QString, int> attribBits;
+    // Attribute sets for which formats are defined,
+    // by their index into formats.
+    QHash<quint64, int> attribSets;
+    // Formats, indexed by attribute set index and visual format index.
+    QList<KuitTagFormat> formats;
+    int leadingNewlines = 0;
+
+    static constexpr int formatCount = 4;
+
+    KuitTag(const QString &_name, Kuit::TagClass _type, int _id)
         : name(_name)
         , type(_type)
+        , id(_id)
     {
     }
     KuitTag() = default;
 
-    QString format(const QStringList &languages,
-                   const QHash<QString, QString> &attributes,
-                   const QString &text,
-                   const QStringList &tagPath,
-                   Kuit::VisualFormat format) const;
-};
+    static int formatIndex(Kuit::VisualFormat format)
+    {
+        Q_ASSERT(format % 10 == 0 && format / 10 < formatCount);
+        return format / 10;
+    }
 
-QString KuitTag::format(const QStringList &languages,
-                        const QHash<QString, QString> &attributes,
-                        const QString &text,
-                        const QStringList &tagPath,
-                        Kuit::VisualFormat format) const
-{
-    KuitStaticData *s = staticData();
-    QString formattedText = text;
-    QString attribKey = attributeSetKey(attributes.keys());
-    const QHash<Kuit::VisualFormat, KLocalizedString> pattern = patterns.value(attribKey);
-    auto patternIt = pattern.constFind(format);
-    if (patternIt != pattern.constEnd()) {
-        QString modText;
-        Kuit::TagFormatter formatter = formatters.value(attribKey).value(format);
-        if (formatter != nullptr) {
-            modText = formatter(languages, name, attributes, text, tagPath, format);
-        } else {
-            modText = text;
-        }
-        KLocalizedString aggText = *patternIt;
-        // line below is first-aid fix.for e.g. <emphasis strong='true'>.
-        // TODO: proper handling of boolean attributes still needed
-        aggText = aggText.relaxSubs();
-        if (!aggText.isEmpty()) {
-            aggText = aggText.subs(modText);
-            const QStringList attributeOrder = attributeOrders.value(attribKey).value(format);
-            for (const QString &attribName : attributeOrder) {
-                aggText = aggText.subs(attributes.value(attribName));
+    // Attribute set of the given known attributes, empty names are ignored.
+    quint64 attributeSet(const QStringList &attribNames) const
+    {
+        quint64 attribSet = 0;
+        for (const QString &attribName : attribNames) {
+            if (!attribName.isEmpty()) {
+                attribSet |= quint64(1) << attribBits.value(attribName);
             }
-            formattedText = aggText.ignoreMarkup().toString(languages);
-        } else {
-            formattedText = modText;
         }
-    } else if (patterns.contains(attribKey)) {
-        qCWarning(KI18N_KUIT)
-            << QStringLiteral("Undefined visual format for tag <%1> and attribute combination %2: %3.").arg(name, attribKey, s->namesByFormat.value(format));
-    } else {
-        qCWarning(KI18N_KUIT) << QStringLiteral("Undefined attribute combination for tag <%1>: %2.").arg(name, attribKey);
+        return attribSet;
     }
-    return formattedText;
-}
+
+    // Format for the attribute set, or null if none is defined.
+    const KuitTagFormat *findFormat(quint64 attribSet, Kuit::VisualFormat format) const
+    {
+        const int setIndex = attribSets.value(attribSet, -1);
+        if (setIndex < 0) {
+            return nullptr;
+        }
+        const KuitTagFormat &tagFormat = formats.at(setIndex * formatCount + formatIndex(format));
+        return tagFormat.isDefined ? &tagFormat : nullptr;
+    }
+};
+
+// Warnings issued while formatting messages. Texts of messages which
+// caused warnings are not cached, so that they are reported every time.
+static thread_local int s_formatWarnings = 0;
 
 KuitSetup &Kuit::setupForDomain(const QByteArray &domain)
 {
     KuitStaticData *s = staticData();
-    KuitSetup *setup = s->domainSetups.value(domain);
+    KuitSetup *setup = s->domainSetups.load(std::memory_order_acquire)->value(domain);
     if (!setup) {
-        setup = new KuitSetup(domain);
-        s->domainSetups.insert(domain, setup);
+        QMutexLocker lock(&s->domainSetupsMutex);
+        const std::shared_ptr<const QHash<QByteArray, KuitSetup *>> setups = s->domainSetups.load(std::memory_order_relaxed);
+        setup = setups->value(domain);
+        if (!setup) {
+            setup = new KuitSetup(domain);
+            auto extendedSetups = std::make_shared<QHash<QByteArray, KuitSetup *>>(*setups);
+            extendedSetups->insert(domain, setup);
+            s->domainSetups.store(std::move(extendedSetups), std::memory_order_release);
+        }
     }
     return *setup;
 }
 
-class KuitSetupPrivate
+// Tags and formats of a domain setup.
+class KuitSetupData
 {
 public:
     void setTagPattern(const QString &tagName,
@@ -556,48 +1032,77 @@ public:
     void setDefaultMarkup();
     void setDefaultFormats();
 
+    // Known tag by its name, or null.
+    const KuitTag *findTag(const QString &tagName) const
+    {
+        const int tagId = tagIds.value(tagName, -1);
+        return tagId >= 0 ? &knownTags.at(tagId) : nullptr;
+    }
+
+    KuitTag &tag(const QString &tagName, Kuit::TagClass aClass);
+
     QByteArray domain;
-    QHash<QString, KuitTag> knownTags;
+    // Tags by their id, with ids by tag names.
+    QList<KuitTag> knownTags;
+    QHash<QString, int> tagIds;
     QHash<Kuit::Role, QHash<Kuit::Cue, Kuit::VisualFormat>> formatsByRoleCue;
 };
 
-void KuitSetupPrivate::setTagPattern(const QString &tagName,
-                                     const QStringList &attribNames_,
-                                     Kuit::VisualFormat format,
-                                     const KLocalizedString &pattern,
-                                     Kuit::TagFormatter formatter,
-                                     int leadingNewlines_)
+KuitTag &KuitSetupData::tag(const QString &tagName, Kuit::TagClass aClass)
 {
-    auto tagIt = knownTags.find(tagName);
-    if (tagIt == knownTags.end()) {
-        tagIt = knownTags.insert(tagName, KuitTag(tagName, Kuit::PhraseTag));
+    auto idIt = tagIds.constFind(tagName);
+    if (idIt == tagIds.constEnd()) {
+        const int tagId = knownTags.size();
+        knownTags.append(KuitTag(tagName, aClass, tagId));
+        idIt = tagIds.insert(tagName, tagId);
     }
+    return knownTags[*idIt];
+}
 
-    KuitTag &tag = *tagIt;
+void KuitSetupData::setTagPattern(const QString &tagName,
+                                  const QStringList &attribNames_,
+                                  Kuit::VisualFormat format,
+                                  const KLocalizedString &pattern,
+                                  Kuit::TagFormatter formatter,
+                                  int leadingNewlines_)
+{
+    KuitTag &tag = this->tag(tagName, Kuit::PhraseTag);
 
     QStringList attribNames = attribNames_;
     attribNames.removeAll(QString());
+    // Attribute sets are bit masks of the attributes known for the tag.
+    quint64 attribSet = 0;
     for (const QString &attribName : std::as_const(attribNames)) {
-        tag.knownAttribs.insert(attribName);
+        auto bitIt = tag.attribBits.constFind(attribName);
+        if (bitIt == tag.attribBits.constEnd()) {
+            if (tag.attribBits.size() == 64) {
+                qCWarning(KI18N_KUIT) << QStringLiteral("Too many attributes for tag <%1>, pattern not set.").arg(tagName);
+                return;
+            }
+            bitIt = tag.attribBits.insert(attribName, tag.attribBits.size());
+        }
+        attribSet |= quint64(1) << *bitIt;
     }
-    QString attribKey = attributeSetKey(attribNames);
-    tag.attributeOrders[attribKey][format] = attribNames;
-    tag.patterns[attribKey][format] = pattern;
-    tag.formatters[attribKey][format] = formatter;
+    auto setIt = tag.attribSets.constFind(attribSet);
+    if (setIt == tag.attribSets.constEnd()) {
+        setIt = tag.attribSets.insert(attribSet, tag.attribSets.size());
+        tag.formats.resize(tag.formats.size() + KuitTag::formatCount);
+    }
+
+    KuitTagFormat &tagFormat = tag.formats[*setIt * KuitTag::formatCount + KuitTag::formatIndex(format)];
+    tagFormat.isDefined = true;
+    tagFormat.attributeOrder = attribNames;
+    tagFormat.pattern = pattern;
+    tagFormat.formatter = formatter;
     tag.leadingNewlines = leadingNewlines_;
 }
 
-void KuitSetupPrivate::setTagClass(const QString &tagName, Kuit::TagClass aClass)
+void KuitSetupData::setTagClass(const QString &tagName, Kuit::TagClass aClass)
 {
-    auto tagIt = knownTags.find(tagName);
-    if (tagIt == knownTags.end()) {
-        knownTags.insert(tagName, KuitTag(tagName, aClass));
-    } else {
-        tagIt->type = aClass;
-    }
+    tag(tagName, aClass).type = aClass;
 }
 
-void KuitSetupPrivate::setFormatForMarker(const QString &marker, Kuit::VisualFormat format)
+void KuitSetupData::setFormatForMarker(const QString &marker, Kuit::VisualFormat format)
 {
     KuitStaticData *s = staticData();
 
@@ -687,7 +1192,7 @@ static QString tagFormatterInterface(TAG_FORMATTER_ARGS)
     return s->toInterfacePath(languages, text, format);
 }
 
-void KuitSetupPrivate::setDefaultMarkup()
+void KuitSetupData::setDefaultMarkup()
 {
     using namespace Kuit;
 
@@ -711,9 +1216,8 @@ void KuitSetupPrivate::setDefaultMarkup()
         attribNames << attribNames_; \
         setTagPattern(tagName, attribNames, format, pattern, formatter, leadNl); \
         /* Make TermText pattern same as PlainText if not explicitly given. */ \
-        KuitTag &tag = knownTags[tagName]; \
-        QString attribKey = attributeSetKey(attribNames); \
-        if (format == PlainText && !tag.patterns[attribKey].contains(TermText)) { \
+        const KuitTag &tag = knownTags.at(tagIds.value(tagName)); \
+        if (format == PlainText && !tag.findFormat(tag.attributeSet(attribNames), TermText)) { \
             setTagPattern(tagName, attribNames, TermText, pattern, formatter, leadNl); \
         } \
     } while (0)
@@ -1082,7 +1586,7 @@ void KuitSetupPrivate::setDefaultMarkup()
     // clang-format on
 }
 
-void KuitSetupPrivate::setDefaultFormats()
+void KuitSetupData::setDefaultFormats()
 {
     using namespace Kuit;
 
@@ -1101,12 +1605,49 @@ void KuitSetupPrivate::setDefaultFormats()
     formatsByRoleCue[Role::InfoRole][ShellCue] = TermText;
 }
 
+// Messages are formatted using the current version of the setup data,
+// which is never modified. Modifications are made on a copy of it,
+// which is then published in its place. Formatters hold on to the version
+// they started with, so a replaced version is freed once they are done.
+class KuitSetupPrivate
+{
+public:
+    explicit KuitSetupPrivate(const QByteArray &domain);
+
+    std::shared_ptr<const KuitSetupData> data() const
+    {
+        return current.load(std::memory_order_acquire);
+    }
+
+    template<typename Modification>
+    void modify(Modification modification);
+
+    std::atomic<std::shared_ptr<const KuitSetupData>> current;
+    QMutex mutex;
+};
+
+KuitSetupPrivate::KuitSetupPrivate(const QByteArray &domain)
+{
+    auto data = std::make_shared<KuitSetupData>();
+    data->domain = domain;
+    data->setDefaultMarkup();
+    data->setDefaultFormats();
+    current.store(std::move(data), std::memory_order_release);
+}
+
+template<typename Modification>
+void KuitSetupPrivate::modify(Modification modification)
+{
+    QMutexLocker lock(&mutex);
+    auto modified = std::make_shared<KuitSetupData>(*current.load(std::memory_order_relaxed));
+    modification(*modified);
+    current.store(std::move(modified), std::memory_order_release);
+    staticData()->setupGeneration.ref();
+}
+
 KuitSetup::KuitSetup(const QByteArray &domain)
-    : d(new KuitSetupPrivate)
+    : d(new KuitSetupPrivate(domain))
 {
-    d->domain = domain;
-    d->setDefaultMarkup();
-    d->setDefaultFormats();
 }
 
 KuitSetup::~KuitSetup()
@@ -1121,17 +1662,138 @@ void KuitSetup::setTagPattern(const QString &tagName,
                               Kuit::TagFormatter formatter,
                               int leadingNewlines)
 {
-    d->setTagPattern(tagName, attribNames, format, pattern, formatter, leadingNewlines);
+    d->modify([&](KuitSetupData &data) {
+        data.setTagPattern(tagName, attribNames, format, pattern, formatter, leadingNewlines);
+    });
 }
 
 void KuitSetup::setTagClass(const QString &tagName, Kuit::TagClass aClass)
 {
-    d->setTagClass(tagName, aClass);
+    d->modify([&](KuitSetupData &data) {
+        data.setTagClass(tagName, aClass);
+    });
 }
 
 void KuitSetup::setFormatForMarker(const QString &marker, Kuit::VisualFormat format)
 {
-    d->setFormatForMarker(marker, format);
+    d->modify([&](KuitSetupData &data) {
+        data.setFormatForMarker(marker, format);
+    });
+}
+
+// Formatted texts are cached by the formatter of each language.
+class KuitFormattedTextKey
+{
+public:
+    QByteArray domain;
+    // Only when the visual format is determined by the UI marker in it.
+    QString context;
+    QString text;
+    Kuit::VisualFormat format;
+
+    bool operator==(const KuitFormattedTextKey &other) const
+    {
+        return format == other.format && text == other.text && context == other.context && domain == other.domain;
+    }
+};
+
+static size_t qHash(const KuitFormattedTextKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.text, key.context, key.domain, int(key.format));
+}
+
+// Tag pattern translated into the language of a formatter, with slots
+// for the element text (first) and attribute values (in pattern order).
+class KuitTagTemplate
+{
+public:
+    KuitTagTemplate() = default;
+    KuitTagTemplate(const KLocalizedString &pattern, qsizetype slotCount, const QStringList &languages);
+
+    QString substitute(const QStringList &values) const;
+
+    struct Segment {
+        qsizetype position;
+        qsizetype length;
+        // Slot following the text, -1 for the text after the last slot.
+        int slot;
+    };
+
+    QString translation;
+    QList<Segment> segments;
+    qsizetype literalLength = 0;
+};
+
+KuitTagTemplate::KuitTagTemplate(const KLocalizedString &pattern, qsizetype slotCount, const QStringList &languages)
+{
+    // Translate the pattern with its placeholders substituted by themselves,
+    // and find where the translation puts them.
+    // relaxSubs is first-aid fix.for e.g. <emphasis strong='true'>.
+    // TODO: proper handling of boolean attributes still needed
+    KLocalizedString aggText = pattern.relaxSubs().ignoreMarkup();
+    for (qsizetype i = 1; i <= slotCount; ++i) {
+        aggText = aggText.subs(QL1C('%') + QString::number(i));
+    }
+    translation = aggText.toString(languages);
+
+    const QStringView text = translation;
+    qsizetype spos = 0;
+    qsizetype tpos = text.indexOf(QL1C('%'));
+    while (tpos >= 0) {
+        const qsizetype ctpos = tpos++;
+        int ordinal = 0;
+        while (tpos < text.size() && text[tpos].digitValue() >= 0) {
+            ordinal = 10 * ordinal + text[tpos].digitValue();
+            ++tpos;
+        }
+        if (ordinal > 0 && ordinal <= slotCount) {
+            segments.append({spos, ctpos - spos, ordinal - 1});
+            literalLength += ctpos - spos;
+            spos = tpos;
+        }
+        tpos = text.indexOf(QL1C('%'), tpos);
+    }
+    segments.append({spos, text.size() - spos, -1});
+    literalLength += text.size() - spos;
+}
+
+QString KuitTagTemplate::substitute(const QStringList &values) const
+{
+    qsizetype length = literalLength;
+    for (const Segment &segment : segments) {
+        if (segment.slot >= 0) {
+            length += values.at(segment.slot).size();
+        }
+    }
+
+    QString text;
+    text.reserve(length);
+    for (const Segment &segment : segments) {
+        text += QStringView(translation).mid(segment.position, segment.length);
+        if (segment.slot >= 0) {
+            text += values.at(segment.slot);
+        }
+    }
+    return text;
+}
+
+class KuitTagTemplateKey
+{
+public:
+    QByteArray domain;
+    int tagId;
+    quint64 attribSet;
+    Kuit::VisualFormat format;
+
+    bool operator==(const KuitTagTemplateKey &other) const
+    {
+        return tagId == other.tagId && attribSet == other.attribSet && format == other.format && domain == other.domain;
+    }
+};
+
+static size_t qHash(const KuitTagTemplateKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.tagId, key.attribSet, key.domain, int(key.format));
 }
 
 class KuitFormatterPrivate
@@ -1150,20 +1812,22 @@ public:
     // Set data used in transformation of text within tags.
     void setTextTransformData();
 
-    // Determine visual format by parsing the UI marker in the context.
-    static Kuit::VisualFormat formatFromUiMarker(const QString &context, const KuitSetup &setup);
+    // Determine visual format by parsing the UI marker in the context,
+    // or from the format already determined for the context.
+    Kuit::VisualFormat formatFromUiMarker(const QString &context, const KuitSetupData &setup) const;
+    static Kuit::VisualFormat parseFormatFromUiMarker(const QString &context, const KuitSetupData &setup);
 
     // Determine if text has block structure (multiple paragraphs, etc).
-    static bool determineIsStructured(const QString &text, const KuitSetup &setup);
+    static bool determineIsStructured(const QString &text, const KuitSetupData &setup);
 
     // Format KUIT text into visual text.
-    QString toVisualText(const QString &text, Kuit::VisualFormat format, const KuitSetup &setup) const;
+    QString toVisualText(const QString &text, Kuit::VisualFormat format, const KuitSetupData &setup) const;
 
     // Final touches to the formatted text.
     QString finalizeVisualText(const QString &ftext, Kuit::VisualFormat format) const;
 
     // In case of markup errors, try to make result not look too bad.
-    QString salvageMarkup(const QString &text, Kuit::VisualFormat format, const KuitSetup &setup) const;
+    QString salvageMarkup(const QString &text, Kuit::VisualFormat format, const KuitSetupData &setup) const;
 
     // Data for XML parsing state.
     class OpenEl
@@ -1172,6 +1836,9 @@ public:
         enum Handling { Proper, Ignored, Dropout };
 
         QString name;
+        // Id of the tag and set of its attributes, for known tags.
+        int tagId = -1;
+        quint64 attribSet = 0;
         QHash<QString, QString> attributes;
         QString attribStr;
         Handling handling;
@@ -1180,10 +1847,23 @@ public:
     };
 
     // Gather data about current element for the parse state.
-    KuitFormatterPrivate::OpenEl parseOpenEl(const QXmlStreamReader &xml, const OpenEl &enclosingOel, const QString &text, const KuitSetup &setup) const;
+    KuitFormatterPrivate::OpenEl parseOpenEl(QStringView name,
+                                             const QList<KuitTokenizer::Attribute> &attributes,
+                                             const OpenEl &enclosingOel,
+                                             const QString &text,
+                                             const KuitSetupData &setup) const;
+
+    // Format text of the element by the pattern of its tag.
+    QString formatTag(const KuitTag &tag,
+                      const KuitSetupData &setup,
+                      quint64 attribSet,
+                      const QHash<QString, QString> &attributes,
+                      const QString &text,
+                      const QStringList &tagPath,
+                      Kuit::VisualFormat format) const;
 
     // Format text of the element.
-    QString formatSubText(const QString &ptext, const OpenEl &oel, Kuit::VisualFormat format, const KuitSetup &setup) const;
+    QString formatSubText(const QString &ptext, const OpenEl &oel, Kuit::VisualFormat format, const KuitSetupData &setup) const;
 
     // Count number of newlines at start and at end of text.
     static void countWrappingNewlines(const QString &ptext, int &numle, int &numtr);
@@ -1196,16 +1876,44 @@ private:
     QHash<Kuit::VisualFormat, QString> guiPathDelim;
 
     QHash<QString, QString> keyNames;
+
+    // Recently formatted texts and tag patterns translated into the language,
+    // valid for the setup generation.
+    mutable QCache<KuitFormattedTextKey, QString> formattedTexts{1024};
+    mutable QHash<KuitTagTemplateKey, KuitTagTemplate> tagTemplates;
+    // Formats determined from the UI markers in message contexts, by domain.
+    mutable QCache<std::pair<QByteArray, QString>, Kuit::VisualFormat> formatsByContext{4096};
+    mutable int formattedTextsGeneration = -1;
 };
 
 KuitFormatterPrivate::KuitFormatterPrivate(const QString &language_)
     : language(language_)
+    , languageAsList{language_}
 {
 }
 
 QString KuitFormatterPrivate::format(const QByteArray &domain, const QString &context, const QString &text, Kuit::VisualFormat format) const
 {
-    const KuitSetup &setup = Kuit::setupForDomain(domain);
+    KuitStaticData *s = staticData();
+
+    // Markup of most messages is formatted the same every time they are shown,
+    // unless tag patterns or formats were set up differently since.
+    const int setupGeneration = s->setupGeneration.loadAcquire();
+    if (formattedTextsGeneration != setupGeneration) {
+        formattedTexts.clear();
+        tagTemplates.clear();
+        formatsByContext.clear();
+        formattedTextsGeneration = setupGeneration;
+    }
+    const KuitFormattedTextKey key{domain, format == Kuit::UndefinedFormat ? context : QString(), text, format};
+    if (const QString *cachedText = formattedTexts.object(key)) {
+        return *cachedText;
+    }
+    const int formatWarnings = s_formatWarnings;
+
+    // The same version of the setup is used throughout, even if it gets modified meanwhile.
+    const std::shared_ptr<const KuitSetupData> setupVersion = Kuit::setupForDomain(domain).d->data();
+    const KuitSetupData &setup = *setupVersion;
 
     // If format is undefined, determine it based on UI marker inside context.
     Kuit::VisualFormat resolvedFormat = format;
@@ -1224,10 +1932,31 @@ QString KuitFormatterPrivate::format(const QByteArray &domain, const QString &co
             ftext = salvageMarkup(text, resolvedFormat, setup);
         }
     }
+
+    if (s_formatWarnings == formatWarnings) {
+        formattedTexts.insert(key, new QString(ftext));
+    }
     return ftext;
 }
 
-Kuit::VisualFormat KuitFormatterPrivate::formatFromUiMarker(const QString &context, const KuitSetup &setup)
+Kuit::VisualFormat KuitFormatterPrivate::formatFromUiMarker(const QString &context, const KuitSetupData &setup) const
+{
+    // Contexts repeat for every message shown in the same kind of place,
+    // so the UI marker in each is parsed only once.
+    const std::pair<QByteArray, QString> key{setup.domain, context};
+    if (const Kuit::VisualFormat *format = formatsByContext.object(key)) {
+        return *format;
+    }
+    // Contexts with faulty markers are not remembered, to be reported every time.
+    const int formatWarnings = s_formatWarnings;
+    const Kuit::VisualFormat format = parseFormatFromUiMarker(context, setup);
+    if (s_formatWarnings == formatWarnings) {
+        formatsByContext.insert(key, new Kuit::VisualFormat(format));
+    }
+    return format;
+}
+
+Kuit::VisualFormat KuitFormatterPrivate::parseFormatFromUiMarker(const QString &context, const KuitSetupData &setup)
 {
     KuitStaticData *s = staticData();
 
@@ -1240,6 +1969,7 @@ Kuit::VisualFormat KuitFormatterPrivate::formatFromUiMarker(const QString &conte
     Kuit::Role role = s->rolesByName.value(roleName, Kuit::Role::UndefinedRole);
     if (role == Kuit::Role::UndefinedRole) { // unknown role
         if (!roleName.isEmpty()) {
+            ++s_formatWarnings;
             qCWarning(KI18N_KUIT) << QStringLiteral("Unknown role '@%1' in UI marker in context {%2}.").arg(roleName, shorten(context));
         }
     }
@@ -1251,11 +1981,13 @@ Kuit::VisualFormat KuitFormatterPrivate::formatFromUiMarker(const QString &conte
         if (cue != Kuit::UndefinedCue) { // known subcue
             if (!s->knownRoleCues.value(role).contains(cue)) {
                 cue = Kuit::UndefinedCue;
+                ++s_formatWarnings;
                 qCWarning(KI18N_KUIT)
                     << QStringLiteral("Subcue ':%1' does not belong to role '@%2' in UI marker in context {%3}.").arg(cueName, roleName, shorten(context));
             }
         } else { // unknown or not given subcue
             if (!cueName.isEmpty()) {
+                ++s_formatWarnings;
                 qCWarning(KI18N_KUIT) << QStringLiteral("Unknown subcue ':%1' in UI marker in context {%2}.").arg(cueName, shorten(context));
             }
         }
@@ -1269,8 +2001,8 @@ Kuit::VisualFormat KuitFormatterPrivate::formatFromUiMarker(const QString &conte
     if (format == Kuit::UndefinedFormat) { // unknown or not given format
         // Check first if there is a format defined for role/subcue
         // combination, then for role only, otherwise default to undefined.
-        auto formatsByCueIt = setup.d->formatsByRoleCue.constFind(role);
-        if (formatsByCueIt != setup.d->formatsByRoleCue.constEnd()) {
+        auto formatsByCueIt = setup.formatsByRoleCue.constFind(role);
+        if (formatsByCueIt != setup.formatsByRoleCue.constEnd()) {
             const auto &formatsByCue = *formatsByCueIt;
             auto formatIt = formatsByCue.constFind(cue);
             if (formatIt != formatsByCue.constEnd()) {
@@ -1280,6 +2012,7 @@ Kuit::VisualFormat KuitFormatterPrivate::formatFromUiMarker(const QString &conte
             }
         }
         if (!formatName.isEmpty()) {
+            ++s_formatWarnings;
             qCWarning(KI18N_KUIT) << QStringLiteral("Unknown format '/%1' in UI marker for message {%2}.").arg(formatName, shorten(context));
         }
     }
@@ -1290,7 +2023,7 @@ Kuit::VisualFormat KuitFormatterPrivate::formatFromUiMarker(const QString &conte
     return format;
 }
 
-bool KuitFormatterPrivate::determineIsStructured(const QString &text, const KuitSetup &setup)
+bool KuitFormatterPrivate::determineIsStructured(const QString &text, const KuitSetupData &setup)
 {
     // If the text opens with a structuring tag, then it is structured,
     // otherwise not. Leading whitespace is ignored for this purpose.
@@ -1299,146 +2032,81 @@ bool KuitFormatterPrivate::determineIsStructured(const QString &text, const Kuit
     const QRegularExpressionMatch match = opensWithTagRx.match(text);
     if (match.hasMatch()) {
         const QString tagName = match.captured(1).toLower();
-        auto tagIt = setup.d->knownTags.constFind(tagName);
-        if (tagIt != setup.d->knownTags.constEnd()) {
-            const KuitTag &tag = *tagIt;
-            isStructured = (tag.type == Kuit::StructTag);
+        if (const KuitTag *tag = setup.findTag(tagName)) {
+            isStructured = (tag->type == Kuit::StructTag);
         }
     }
     return isStructured;
 }
 
-static const char s_entitySubRx[] = "[a-z]+|#[0-9]+|#x[0-9a-fA-F]+";
-
-QString KuitFormatterPrivate::toVisualText(const QString &text_, Kuit::VisualFormat format, const KuitSetup &setup) const
+QString KuitFormatterPrivate::toVisualText(const QString &text, Kuit::VisualFormat format, const KuitSetupData &setup) const
 {
-    KuitStaticData *s = staticData();
-
-    // Replace &-shortcut marker with "&amp;", not to confuse the parser;
-    // but do not touch & which forms an XML entity as it is.
-    QString original = text_;
-    // Regex is (see s_entitySubRx var): ^([a-z]+|#[0-9]+|#x[0-9a-fA-F]+);
-    static const QRegularExpression restRx(QLatin1String("^(") + QLatin1String(s_entitySubRx) + QLatin1String(");"));
-
-    QString text;
-    int p = original.indexOf(QL1C('&'));
-    while (p >= 0) {
-        text.append(QStringView(original).mid(0, p + 1));
-        original.remove(0, p + 1);
-        if (original.indexOf(restRx) != 0) { // not an entity
-            text.append(QSL("amp;"));
-        }
-        p = original.indexOf(QL1C('&'));
-    }
-    text.append(original);
-
     // FIXME: Do this and then check proper use of structuring and phrase tags.
 #if 0
     // Determine whether this is block-structured text.
     bool isStructured = determineIsStructured(text, setup);
 #endif
 
-    const QString INTERNAL_TOP_TAG_NAME = QStringLiteral("__kuit_internal_top__");
-    // Add top tag, not to confuse the parser.
-    text = QStringLiteral("<%2>%1</%2>").arg(text, INTERNAL_TOP_TAG_NAME);
-
+    // The whole text is the content of the internal top element.
     QStack<OpenEl> openEls;
-    QXmlStreamReader xml(text);
-    xml.setEntityResolver(&s->xmlEntityResolver);
-    QStringView lastElementName;
+    OpenEl topEl;
+    topEl.name = QStringLiteral("__kuit_internal_top__");
+    topEl.tagId = setup.tagIds.value(topEl.name);
+    topEl.handling = OpenEl::Proper;
+    openEls.push(topEl);
 
-    while (!xml.atEnd()) {
-        xml.readNext();
-
-        if (xml.isStartElement()) {
-            lastElementName = xml.name();
-
-            OpenEl oel;
-
-            if (openEls.isEmpty()) {
-                // Must be the root element.
-                oel.name = INTERNAL_TOP_TAG_NAME;
-                oel.handling = OpenEl::Proper;
-            } else {
-                // Find first proper enclosing element.
-                OpenEl enclosingOel;
-                for (int i = openEls.size() - 1; i >= 0; --i) {
-                    if (openEls[i].handling == OpenEl::Proper) {
-                        enclosingOel = openEls[i];
-                        break;
-                    }
-                }
-                // Collect data about this element.
-                oel = parseOpenEl(xml, enclosingOel, text, setup);
-            }
-
-            // Record the new element on the parse stack.
-            openEls.push(oel);
-        } else if (xml.isEndElement()) {
-            // Get closed element data.
-            OpenEl oel = openEls.pop();
+    KuitTokenizer tokenizer(text);
+    QStringView lastElementName;
 
-            // If this was closing of the top element, we're done.
-            if (openEls.isEmpty()) {
-                // Return with final touches applied.
-                return finalizeVisualText(oel.formattedText, format);
+    for (;;) {
+        switch (tokenizer.readNext()) {
+        case KuitTokenizer::StartElement: {
+            lastElementName = tokenizer.name();
+            // Find first proper enclosing element.
+            qsizetype i = openEls.size() - 1;
+            while (openEls[i].handling != OpenEl::Proper) {
+                --i;
             }
-
+            // Collect data about this element and record it on the parse stack.
+            openEls.push(parseOpenEl(tokenizer.name(), tokenizer.attributes(), openEls[i], text, setup));
+            break;
+        }
+        case KuitTokenizer::EndElement: {
             // Append formatted text segment.
-            QString ptext = openEls.top().formattedText; // preceding text
-            openEls.top().formattedText += formatSubText(ptext, oel, format, setup);
-        } else if (xml.isCharacters()) {
-            // Stream reader will automatically resolve default XML entities,
-            // which is not desired in this case, as the entities are to be
-            // resolved in finalizeVisualText. Convert back into entities.
-            const QString ctext = xml.text().toString();
-            QString nctext;
-            for (const QChar c : ctext) {
-                auto nameIt = s->xmlEntitiesInverse.constFind(c);
-                if (nameIt != s->xmlEntitiesInverse.constEnd()) {
-                    const QString &entName = *nameIt;
-                    nctext += QL1C('&') + entName + QL1C(';');
-                } else {
-                    nctext += c;
-                }
-            }
-            openEls.top().formattedText += nctext;
+            const OpenEl oel = openEls.pop();
+            QString &ptext = openEls.top().formattedText; // preceding text
+            ptext += formatSubText(ptext, oel, format, setup);
+            break;
+        }
+        case KuitTokenizer::Characters:
+            openEls.top().formattedText += tokenizer.characters();
+            break;
+        case KuitTokenizer::EndOfText:
+            // Return with final touches applied.
+            return finalizeVisualText(openEls.top().formattedText, format);
+        case KuitTokenizer::Invalid:
+            ++s_formatWarnings;
+            qCWarning(KI18N_KUIT) << QStringLiteral("Markup error in message {%1}: %2. Last tag parsed: %3. Complete message follows:\n%4")
+                                         .arg(shorten(text), tokenizer.errorString(), lastElementName.toString(), text);
+            return QString();
         }
     }
-
-    if (xml.hasError()) {
-        qCWarning(KI18N_KUIT) << QStringLiteral("Markup error in message {%1}: %2. Last tag parsed: %3. Complete message follows:\n%4")
-                                     .arg(shorten(text), xml.errorString(), lastElementName.toString(), text);
-        return QString();
-    }
-
-    // Cannot reach here.
-    return text;
 }
 
 KuitFormatterPrivate::OpenEl
-KuitFormatterPrivate::parseOpenEl(const QXmlStreamReader &xml, const OpenEl &enclosingOel, const QString &text, const KuitSetup &setup) const
+KuitFormatterPrivate::parseOpenEl(QStringView name,
+                                  const QList<KuitTokenizer::Attribute> &attributes,
+                                  const OpenEl &enclosingOel,
+                                  const QString &text,
+                                  const KuitSetupData &setup) const
 {
     OpenEl oel;
-    oel.name = xml.name().toString().toLower();
-
-    // Collect attribute names and values, and format attribute string.
-    QStringList attribNames;
-    QStringList attribValues;
-    const auto listAttributes = xml.attributes();
-    attribNames.reserve(listAttributes.size());
-    attribValues.reserve(listAttributes.size());
-    for (const QXmlStreamAttribute &xatt : listAttributes) {
-        attribNames += xatt.name().toString().toLower();
-        attribValues += xatt.value().toString();
-        QChar qc = attribValues.last().indexOf(QL1C('\'')) < 0 ? QL1C('\'') : QL1C('"');
-        oel.attribStr += QL1C(' ') + attribNames.last() + QL1C('=') + qc + attribValues.last() + qc;
-    }
-
-    auto tagIt = setup.d->knownTags.constFind(oel.name);
-    if (tagIt != setup.d->knownTags.constEnd()) { // known KUIT element
-        const KuitTag &tag = *tagIt;
-        const KuitTag &etag = setup.d->knownTags.value(enclosingOel.name);
+    oel.name = name.toString().toLower();
+
+    if (const KuitTag *knownTag = setup.findTag(oel.name)) { // known KUIT element
+        const KuitTag &tag = *knownTag;
+        const KuitTag &etag = setup.knownTags.at(enclosingOel.tagId);
+        oel.tagId = tag.id;
 
         // If this element can be contained within enclosing element,
         // mark it proper, otherwise mark it for removal.
@@ -1446,18 +2114,20 @@ KuitFormatterPrivate::parseOpenEl(const QXmlStreamReader &xml, const OpenEl &enc
             oel.handling = OpenEl::Proper;
         } else {
             oel.handling = OpenEl::Dropout;
+            ++s_formatWarnings;
             qCWarning(KI18N_KUIT)
                 << QStringLiteral("Structuring tag ('%1') cannot be subtag of phrase tag ('%2') in message {%3}.").arg(tag.name, etag.name, shorten(text));
         }
 
-        // Resolve attributes and compute attribute set key.
-        QSet<QString> attset;
-        for (int i = 0; i < attribNames.size(); ++i) {
-            QString att = attribNames[i];
-            if (tag.knownAttribs.contains(att)) {
-                attset << att;
-                oel.attributes[att] = attribValues[i];
+        // Resolve attributes and compute attribute set.
+        for (const KuitTokenizer::Attribute &xatt : attributes) {
+            const QString att = xatt.name.toString().toLower();
+            const auto bitIt = tag.attribBits.constFind(att);
+            if (bitIt != tag.attribBits.constEnd()) {
+                oel.attribSet |= quint64(1) << *bitIt;
+                oel.attributes.insert(att, xatt.value);
             } else {
+                ++s_formatWarnings;
                 qCWarning(KI18N_KUIT) << QStringLiteral("Attribute '%1' not defined for tag '%2' in message {%3}.").arg(att, tag.name, shorten(text));
             }
         }
@@ -1468,17 +2138,72 @@ KuitFormatterPrivate::parseOpenEl(const QXmlStreamReader &xml, const OpenEl &enc
 
     } else { // unknown element, leave it in verbatim
         oel.handling = OpenEl::Ignored;
+        // Format attribute string.
+        for (const KuitTokenizer::Attribute &xatt : attributes) {
+            const QChar qc = xatt.value.indexOf(QL1C('\'')) < 0 ? QL1C('\'') : QL1C('"');
+            oel.attribStr += QL1C(' ') + xatt.name.toString().toLower() + QL1C('=') + qc + xatt.value + qc;
+        }
+        ++s_formatWarnings;
         qCWarning(KI18N_KUIT) << QStringLiteral("Tag '%1' is not defined in message {%2}.").arg(oel.name, shorten(text));
     }
 
     return oel;
 }
 
-QString KuitFormatterPrivate::formatSubText(const QString &ptext, const OpenEl &oel, Kuit::VisualFormat format, const KuitSetup &setup) const
+QString KuitFormatterPrivate::formatTag(const KuitTag &tag,
+                                        const KuitSetupData &setup,
+                                        quint64 attribSet,
+                                        const QHash<QString, QString> &attributes,
+                                        const QString &text,
+                                        const QStringList &tagPath,
+                                        Kuit::VisualFormat format) const
+{
+    const KuitTagFormat *tagFormat = tag.findFormat(attribSet, format);
+    if (!tagFormat) {
+        KuitStaticData *s = staticData();
+        const QString attribKey = attributeSetKey(attributes.keys());
+        ++s_formatWarnings;
+        if (tag.attribSets.contains(attribSet)) {
+            qCWarning(KI18N_KUIT)
+                << QStringLiteral("Undefined visual format for tag <%1> and attribute combination %2: %3.").arg(tag.name, attribKey, s->namesByFormat.value(format));
+        } else {
+            qCWarning(KI18N_KUIT) << QStringLiteral("Undefined attribute combination for tag <%1>: %2.").arg(tag.name, attribKey);
+        }
+        return text;
+    }
+
+    QString modText;
+    if (tagFormat->formatter != nullptr) {
+        modText = tagFormat->formatter(languageAsList, tag.name, attributes, text, tagPath, format);
+    } else {
+        modText = text;
+    }
+    if (tagFormat->pattern.isEmpty()) {
+        return modText;
+    }
+
+    const QStringList &attributeOrder = tagFormat->attributeOrder;
+    // The pattern is translated once, afterwards only the slots are filled.
+    const KuitTagTemplateKey key{setup.domain, tag.id, attribSet, format};
+    auto templateIt = tagTemplates.constFind(key);
+    if (templateIt == tagTemplates.constEnd()) {
+        templateIt = tagTemplates.insert(key, KuitTagTemplate(tagFormat->pattern, 1 + attributeOrder.size(), languageAsList));
+    }
+
+    QStringList values;
+    values.reserve(1 + attributeOrder.size());
+    values.append(modText);
+    for (const QString &attribName : attributeOrder) {
+        values.append(attributes.value(attribName));
+    }
+    return templateIt->substitute(values);
+}
+
+QString KuitFormatterPrivate::formatSubText(const QString &ptext, const OpenEl &oel, Kuit::VisualFormat format, const KuitSetupData &setup) const
 {
     if (oel.handling == OpenEl::Proper) {
-        const KuitTag &tag = setup.d->knownTags.value(oel.name);
-        QString ftext = tag.format(languageAsList, oel.attributes, oel.formattedText, oel.tagPath, format);
+        const KuitTag &tag = setup.knownTags.at(oel.tagId);
+        QString ftext = formatTag(tag, setup, oel.attribSet, oel.attributes, oel.formattedText, oel.tagPath, format);
 
         // Handle leading newlines, if this is not start of the text
         // (ptext is the preceding text).
@@ -1527,37 +2252,11 @@ void KuitFormatterPrivate::countWrappingNewlines(const QString &text, int &numle
 
 QString KuitFormatterPrivate::finalizeVisualText(const QString &text_, Kuit::VisualFormat format) const
 {
-    KuitStaticData *s = staticData();
-
     QString text = text_;
 
     // Resolve XML entities.
     if (format != Kuit::RichText) {
-        // regex is (see s_entitySubRx var): (&([a-z]+|#[0-9]+|#x[0-9a-fA-F]+);)
-        static const QRegularExpression entRx(QLatin1String("(&(") + QLatin1String(s_entitySubRx) + QLatin1String(");)"));
-        QRegularExpressionMatch match;
-        QString plain;
-        while ((match = entRx.match(text)).hasMatch()) {
-            plain.append(QStringView(text).mid(0, match.capturedStart(0)));
-            text.remove(0, match.capturedEnd(0));
-            const QString ent = match.captured(2);
-            if (ent.startsWith(QL1C('#'))) { // numeric character entity
-                bool ok;
-                QStringView entView(ent);
-                const QChar c = ent.at(1) == QL1C('x') ? QChar(entView.mid(2).toInt(&ok, 16)) : QChar(entView.mid(1).toInt(&ok, 10));
-                if (ok) {
-                    plain.append(c);
-                } else { // unknown Unicode point, leave as is
-                    plain.append(match.capturedView(0));
-                }
-            } else if (s->xmlEntities.contains(ent)) { // known entity
-                plain.append(s->xmlEntities[ent]);
-            } else { // unknown entity, just leave as is
-                plain.append(match.capturedView(0));
-            }
-        }
-        plain.append(text);
-        text = plain;
+        text = resolveEntities(text);
     }
 
     // Add top tag.
@@ -1568,7 +2267,7 @@ QString KuitFormatterPrivate::finalizeVisualText(const QString &text_, Kuit::Vis
     return text;
 }
 
-QString KuitFormatterPrivate::salvageMarkup(const QString &text_, Kuit::VisualFormat format, const KuitSetup &setup) const
+QString KuitFormatterPrivate::salvageMarkup(const QString &text_, Kuit::VisualFormat format, const KuitSetupData &setup) const
 {
     QString text = text_;
     QString ntext;
@@ -1585,12 +2284,10 @@ QString KuitFormatterPrivate::salvageMarkup(const QString &text_, Kuit::VisualFo
         ntext += QStringView(text).mid(pos, match.capturedStart(0) - pos);
         const QString tagname = match.captured(2).toLower();
         const QString content = salvageMarkup(match.captured(4), format, setup);
-        auto tagIt = setup.d->knownTags.constFind(tagname);
-        if (tagIt != setup.d->knownTags.constEnd()) {
-            const KuitTag &tag = *tagIt;
+        if (const KuitTag *tag = setup.findTag(tagname)) {
             QHash<QString, QString> attributes;
             // TODO: Do not ignore attributes (in match.captured(3)).
-            ntext += tag.format(languageAsList, attributes, content, QStringList(), format);
+            ntext += formatTag(*tag, setup, 0, attributes, content, QStringList(), format);
         } else {
             ntext += match.captured(1) + content + match.captured(5);
         }
@@ -1609,10 +2306,8 @@ QString KuitFormatterPrivate::salvageMarkup(const QString &text_, Kuit::VisualFo
         match = iter.next();
         ntext += QStringView(text).mid(pos, match.capturedStart(0) - pos);
         const QString tagname = match.captured(1).toLower();
-        auto tagIt = setup.d->knownTags.constFind(tagname);
-        if (tagIt != setup.d->knownTags.constEnd()) {
-            const KuitTag &tag = *tagIt;
-            ntext += tag.format(languageAsList, QHash<QString, QString>(), QString(), QStringList(), format);
+        if (const KuitTag *tag = setup.findTag(tagname)) {
+            ntext += formatTag(*tag, setup, 0, QHash<QString, QString>(), QString(), QStringList(), format);
         } else {
             ntext += match.captured(0);
         }